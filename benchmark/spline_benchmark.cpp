@@ -0,0 +1,880 @@
+// Throughput of the headless spline core and draw list building, no window or GPU needed.
+//
+//  SplineBenchmark [--quick] [--max-ctrl-pts N] [--min-time SECONDS] [--threads N] [--output FILE]
+//
+// Results are written as JSON to FILE, or to stdout ; a readable summary goes to stderr.
+// Configure with -DCMAKE_BUILD_TYPE=Release -DSPLINE_BUILD_EDITOR=OFF for meaningful numbers.
+
+#include "../src/cubic_bezier_spline_2d/cubic_bezier_spline_2d.h"
+#include "../src/cubic_hermite_spline_2d/cubic_hermite_spline_2d.h"
+#include "../src/cubic_bspline_2d/cubic_bspline_2d.h"
+#include "../src/bspline/bspline.h"
+#include "../src/bspline_fit/bspline_fit.h"
+#include "../src/arc_length_table/arc_length_table.h"
+#include "../src/cubic_polynomial_2d/cubic_polynomial_2d.h"
+#include "../src/discretization/discretization.h"
+#include "../src/scene/scene.h"
+#include "../src/scene_generator/scene_generator.h"
+#include "../src/scene_file/scene_file.h"
+#include "../src/svg_importer/svg_importer.h"
+#include "../src/draw_list_builder/draw_list_builder.h"
+#include "../src/task_pool/task_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+    struct settings
+    {
+        size_t max_ctrl_pts = 1 << 20;
+        double min_time = 0.1;
+        bool quick = false;
+        size_t threads = TaskPool::DefaultNbWorkers() + 1;
+        const char* output = nullptr;
+    };
+
+    struct result
+    {
+        std::string benchmark;
+        std::string spline_type;
+        size_t ctrl_pts = 0;
+        size_t items = 0;
+        size_t iterations = 0;
+        double seconds = 0.0;
+    };
+
+    // Keeps the optimizer from dropping the measured work.
+    volatile float sink = 0.f;
+
+    void Consume(const glm::vec2& p)
+    {
+        sink = sink + p.x + p.y;
+    }
+
+    // Runs work until min_time has elapsed, after one untimed warm-up run. items is the number of
+    // points, parameters or splines processed by one run.
+    template <class Work>
+    result Measure
+    (
+        const settings& settings,
+        std::string_view benchmark,
+        std::string_view spline_type,
+        size_t ctrl_pts,
+        size_t items,
+        Work&& work
+    )
+    {
+        using clock = std::chrono::steady_clock;
+
+        work();
+
+        result result{ std::string(benchmark), std::string(spline_type), ctrl_pts, items, 0, 0.0 };
+        const auto start = clock::now();
+        do
+        {
+            work();
+            ++result.iterations;
+            result.seconds = std::chrono::duration<double>(clock::now() - start).count();
+        } while (result.seconds < settings.min_time);
+
+        const double ns_per_item = 1e9 * result.seconds / static_cast<double>(result.iterations * result.items);
+        std::fprintf(stderr, "%-32s %-8s %8zu ctrl pts %12.2f ns/item\n", result.benchmark.c_str(), result.spline_type.c_str(), ctrl_pts, ns_per_item);
+        return result;
+    }
+
+    std::vector<double> RandomParameters(uint32_t seed, size_t nb_parameters)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+        std::vector<double> t(nb_parameters);
+        std::ranges::generate(t, [&]() { return distribution(generator); });
+        return t;
+    }
+
+    template <class Spline>
+    void BenchmarkSpline
+    (
+        const settings& settings,
+        std::string_view spline_type,
+        size_t ctrl_pts,
+        std::vector<result>& results
+    )
+    {
+        constexpr size_t nb_parameters = 4096;
+        constexpr float tolerance = 0.25f;
+
+        const std::vector<glm::vec2> points = SceneGenerator::RandomControlPoints(static_cast<uint32_t>(ctrl_pts), ctrl_pts);
+        const Spline spline(points);
+
+        const std::vector<double> t = RandomParameters(1, nb_parameters);
+        std::vector<double> sorted_t = t;
+        std::ranges::sort(sorted_t);
+        std::vector<glm::vec2> pts(nb_parameters);
+
+        const auto nb_pts = static_cast<uint32_t>(std::max<size_t>(1024, 8 * ctrl_pts));
+
+        results.push_back(Measure(settings, "construct", spline_type, ctrl_pts, ctrl_pts, [&]()
+            {
+                const Spline copy(points);
+                Consume(copy.Eval(0.5));
+            }));
+
+        results.push_back(Measure(settings, "eval", spline_type, ctrl_pts, nb_parameters, [&]()
+            {
+                glm::vec2 sum(0.f);
+                for (double ti : t)
+                {
+                    sum += spline.Eval(ti);
+                }
+                Consume(sum);
+            }));
+
+        results.push_back(Measure(settings, "eval_batch_sorted", spline_type, ctrl_pts, nb_parameters, [&]()
+            {
+                spline.Eval(sorted_t, pts);
+                Consume(pts.back());
+            }));
+
+        results.push_back(Measure(settings, "eval_first_derivative", spline_type, ctrl_pts, nb_parameters, [&]()
+            {
+                glm::vec2 sum(0.f);
+                for (double ti : t)
+                {
+                    sum += spline.EvalFirstDerivative(ti);
+                }
+                Consume(sum);
+            }));
+
+        results.push_back(Measure(settings, "discretize_linear", spline_type, ctrl_pts, nb_pts, [&]()
+            {
+                Consume(Discretization::Linear(spline, nb_pts).back());
+            }));
+
+        if constexpr (requires { Discretization::ForwardDifferencing(spline, nb_pts); })
+        {
+            results.push_back(Measure(settings, "discretize_forward_differencing", spline_type, ctrl_pts, nb_pts, [&]()
+                {
+                    Consume(Discretization::ForwardDifferencing(spline, nb_pts).back());
+                }));
+        }
+
+        if constexpr (std::is_same_v<Spline, CubicBSpline2d>)
+        {
+            results.push_back(Measure(settings, "convert_to_bezier", spline_type, ctrl_pts, ctrl_pts, [&]()
+                {
+                    Consume(CubicBezierSpline2d::FromCubicBSpline2d(spline).m_curves.back().P[3]);
+                }));
+        }
+
+        // Items are the output vertices, whose count depends on the shape.
+        const size_t nb_adaptive_pts = Discretization::Adaptive(spline, tolerance).size();
+        results.push_back(Measure(settings, "discretize_adaptive", spline_type, ctrl_pts, nb_adaptive_pts, [&]()
+            {
+                Consume(Discretization::Adaptive(spline, tolerance).back());
+            }));
+
+        const ArcLengthTable<Spline> table(spline);
+        results.push_back(Measure(settings, "arc_length_build", spline_type, ctrl_pts, ctrl_pts, [&]()
+            {
+                Consume(glm::vec2(static_cast<float>(ArcLengthTable<Spline>(spline).GetLength())));
+            }));
+
+        results.push_back(Measure(settings, "arc_length_resample", spline_type, ctrl_pts, nb_pts, [&]()
+            {
+                Consume(Discretization::ArcLength(table, nb_pts).back());
+            }));
+
+        // What dragging a control point costs an arc length sampled spline each frame : the spline
+        // and its table rebuilt, then resampled at the editor's default discretization. Items are the drags.
+        constexpr uint32_t nb_drag_pts = 100;
+        std::vector<glm::vec2> dragged = points;
+        size_t nb_drags = 0;
+        results.push_back(Measure(settings, "arc_length_drag", spline_type, ctrl_pts, 1, [&]()
+            {
+                dragged[ctrl_pts / 2] += glm::vec2((nb_drags++ % 2 == 0) ? 1.f : -1.f, 0.f);
+                const ArcLengthTable<Spline> rebuilt{ Spline(dragged) };
+                Consume(Discretization::ArcLength(rebuilt, nb_drag_pts).back());
+            }));
+    }
+
+    // Single precision evaluation of the templated core, the 3D splines lifting the 2D points on z = x.
+    template <class Spline>
+    void BenchmarkTemplateSpline
+    (
+        const settings& settings,
+        std::string_view spline_type,
+        size_t ctrl_pts,
+        std::vector<result>& results
+    )
+    {
+        using point = typename Spline::point;
+        constexpr size_t nb_parameters = 4096;
+
+        std::vector<point> points;
+        for (const glm::vec2& p : SceneGenerator::RandomControlPoints(static_cast<uint32_t>(ctrl_pts), ctrl_pts))
+        {
+            point q(p.x);
+            q.y = p.y;
+            points.push_back(q);
+        }
+        const Spline spline(points);
+
+        std::vector<float> t;
+        for (double ti : RandomParameters(1, nb_parameters))
+        {
+            t.push_back(static_cast<float>(ti));
+        }
+        std::vector<float> sorted_t = t;
+        std::ranges::sort(sorted_t);
+        std::vector<point> pts(nb_parameters);
+
+        results.push_back(Measure(settings, "eval", spline_type, ctrl_pts, nb_parameters, [&]()
+            {
+                point sum(0.f);
+                for (float ti : t)
+                {
+                    sum += spline.Eval(ti);
+                }
+                Consume(glm::vec2(sum));
+            }));
+
+        results.push_back(Measure(settings, "eval_batch_sorted", spline_type, ctrl_pts, nb_parameters, [&]()
+            {
+                spline.Eval(sorted_t, pts);
+                Consume(glm::vec2(pts.back()));
+            }));
+    }
+
+    // Rebuilds every cached tessellation of a generated scene, as after loading it.
+    void BenchmarkScene
+    (
+        const settings& settings,
+        size_t nb_splines,
+        size_t ctrl_pts,
+        std::vector<result>& results
+    )
+    {
+        data data;
+        SceneGenerator::AddRandomSplines(data, 1, nb_splines, ctrl_pts);
+
+        results.push_back(Measure(settings, "scene_tessellation", "mixed", ctrl_pts, nb_splines, [&]()
+            {
+                for (size_t i = 0; i < nb_splines; ++i)
+                {
+                    data.invalidate_spline(i);
+                    Consume(data.get_tessellation(i).back());
+                }
+            }));
+
+        // Same edit, then only the segments in a 1280 x 720 viewport are tessellated, as the editor draws them.
+        const BoundingBox2d viewport(glm::vec2(1408.f, 1688.f), glm::vec2(2688.f, 2408.f));
+        results.push_back(Measure(settings, "scene_tessellation_visible", "mixed", ctrl_pts, nb_splines, [&]()
+            {
+                for (size_t i = 0; i < nb_splines; ++i)
+                {
+                    data.invalidate_spline(i);
+                }
+                data.get_splines_bvh().Query(viewport, [&](uint32_t i)
+                    {
+                        const std::vector<BoundingBox2d>& segment_bounds = data.splines_cache[i].segment_bounds;
+                        for (size_t segment = 0; segment < segment_bounds.size(); ++segment)
+                        {
+                            if (segment_bounds[segment].Overlaps(viewport))
+                            {
+                                Consume(data.get_tessellation(i, segment, segment).back());
+                            }
+                        }
+                    });
+            }));
+    }
+
+    // Whole scene tessellated on task pools of 1, 2, 4 ... threads, up to settings.threads. The splines
+    // are built once, only the segments are marked again as not evaluated between runs.
+    void BenchmarkParallelScene
+    (
+        const settings& settings,
+        size_t nb_splines,
+        size_t ctrl_pts,
+        std::vector<result>& results
+    )
+    {
+        data data;
+        SceneGenerator::AddRandomSplines(data, 1, nb_splines, ctrl_pts);
+
+        std::vector<tessellation_range> ranges;
+        for (size_t i = 0; i < nb_splines; ++i)
+        {
+            const auto nb_segments = static_cast<uint32_t>(data.splines_cache[i].segment_bounds.size());
+            ranges.push_back({ static_cast<uint32_t>(i), 0, nb_segments > 0 ? nb_segments - 1 : 0 });
+        }
+
+        for (size_t threads = 1; ; threads = std::min(2 * threads, settings.threads))
+        {
+            TaskPool pool(threads - 1);
+            const std::string benchmark = "scene_tessellation_" + std::to_string(threads) + "_threads";
+            results.push_back(Measure(settings, benchmark, "mixed", ctrl_pts, nb_splines, [&]()
+                {
+                    for (spline_cache& cache : data.splines_cache)
+                    {
+                        std::ranges::fill(cache.tessellated_segments, uint8_t(0));
+                    }
+                    data.tessellate(pool, ranges);
+                    Consume(data.splines_cache.back().tessellation.back());
+                }));
+            if (threads == settings.threads)
+            {
+                break;
+            }
+        }
+    }
+
+    // Straightforward reader of the same file : every record and point array read and copied into vectors.
+    size_t ReadSceneFile(const char* path, std::vector<std::vector<glm::vec2>>& splines_points)
+    {
+        std::ifstream file(path, std::ios::binary);
+        SceneFile::header h;
+        file.read(reinterpret_cast<char*>(&h), sizeof(h));
+
+        std::vector<SceneFile::spline_record> records(h.nb_splines);
+        file.seekg(static_cast<std::streamoff>(h.splines_offset));
+        file.read(reinterpret_cast<char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(SceneFile::spline_record)));
+
+        splines_points.assign(h.nb_splines, {});
+        file.seekg(static_cast<std::streamoff>(h.points_offset));
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            splines_points[i].resize(records[i].nb_points);
+            file.read(reinterpret_cast<char*>(splines_points[i].data()), static_cast<std::streamsize>(records[i].nb_points * sizeof(glm::vec2)));
+        }
+        return file ? records.size() : 0;
+    }
+
+    // Scene file loading : mapping and validating it, then reading every point in place, against
+    // the std::ifstream reader above. The file stays in the page cache between runs.
+    void BenchmarkSceneFile
+    (
+        const settings& settings,
+        size_t nb_splines,
+        size_t ctrl_pts,
+        std::vector<result>& results
+    )
+    {
+        const std::string path = (std::filesystem::temp_directory_path() / "spline_benchmark.spl").string();
+        {
+            data data;
+            SceneGenerator::AddRandomSplines(data, 1, nb_splines, ctrl_pts);
+            if (!SceneFile::Write(path.c_str(), data))
+            {
+                std::fprintf(stderr, "cannot write %s\n", path.c_str());
+                return;
+            }
+        }
+
+        results.push_back(Measure(settings, "scene_file_mmap", "mixed", ctrl_pts, nb_splines, [&]()
+            {
+                const auto scene = MappedScene::Open(path.c_str());
+                Consume(scene->GetPoints(scene->GetNbSplines() - 1).back());
+            }));
+
+        results.push_back(Measure(settings, "scene_file_mmap_scan", "mixed", ctrl_pts, nb_splines, [&]()
+            {
+                const auto scene = MappedScene::Open(path.c_str());
+                glm::vec2 sum(0.f);
+                for (size_t i = 0; i < scene->GetNbSplines(); ++i)
+                {
+                    for (const glm::vec2& p : scene->GetPoints(i))
+                    {
+                        sum += p;
+                    }
+                }
+                Consume(sum);
+            }));
+
+        std::vector<std::vector<glm::vec2>> splines_points;
+        results.push_back(Measure(settings, "scene_file_ifstream", "mixed", ctrl_pts, nb_splines, [&]()
+            {
+                ReadSceneFile(path.c_str(), splines_points);
+                Consume(splines_points.back().back());
+            }));
+
+        std::filesystem::remove(path);
+    }
+
+    // SVG import throughput in bytes : the path data tokenized alone, then added to a scene.
+    void BenchmarkSvgImport
+    (
+        const settings& settings,
+        size_t nb_paths,
+        size_t ctrl_pts,
+        std::vector<result>& results
+    )
+    {
+        std::string svg = "<svg xmlns=\"http://www.w3.org/2000/svg\">\n";
+        char number[32];
+        for (size_t i = 0; i < nb_paths; ++i)
+        {
+            const std::vector<glm::vec2> points = SceneGenerator::RandomControlPoints(static_cast<uint32_t>(i), ctrl_pts);
+            svg += "<path fill=\"none\" stroke=\"black\" d=\"M";
+            for (size_t j = 0; j < points.size(); ++j)
+            {
+                svg += j == 0 ? "" : (j % 3 == 1 ? " C" : " ");
+                std::snprintf(number, sizeof(number), "%.2f,%.2f", points[j].x, points[j].y);
+                svg += number;
+            }
+            svg += "\"/>\n";
+        }
+        svg += "</svg>\n";
+
+        results.push_back(Measure(settings, "svg_parse", "bezier", ctrl_pts, svg.size(), [&]()
+            {
+                std::istringstream in(svg);
+                glm::vec2 sum(0.f);
+                SvgImporter::Parse(in, [&](std::span<const glm::vec2> points) { sum += points.back(); });
+                Consume(sum);
+            }));
+
+        results.push_back(Measure(settings, "svg_import", "bezier", ctrl_pts, svg.size(), [&]()
+            {
+                std::istringstream in(svg);
+                data data;
+                SvgImporter::Import(in, data);
+                Consume(data.points_pool.back());
+            }));
+    }
+
+    // Control point under the cursor, scanning every point as the editor used to against the spatial hash.
+    void BenchmarkPicking
+    (
+        const settings& settings,
+        size_t nb_splines,
+        size_t ctrl_pts,
+        std::vector<result>& results
+    )
+    {
+        constexpr size_t nb_queries = 1024;
+        constexpr float radius = 5.f;
+
+        data data;
+        SceneGenerator::AddRandomSplines(data, 2, nb_splines, ctrl_pts);
+
+        // Half of the queries next to a control point, half anywhere.
+        std::mt19937 generator(3);
+        std::uniform_int_distribution<size_t> spline(0, nb_splines - 1);
+        std::uniform_real_distribution<float> jitter(-radius, radius);
+        std::uniform_real_distribution<float> anywhere(0.f, 4096.f);
+        std::vector<glm::vec2> queries(nb_queries);
+        for (size_t i = 0; i < nb_queries; ++i)
+        {
+            if (i % 2 == 0)
+            {
+                const auto points = data.get_points(spline(generator));
+                queries[i] = points[std::uniform_int_distribution<size_t>(0, points.size() - 1)(generator)];
+                queries[i].x += jitter(generator);
+                queries[i].y += jitter(generator);
+            }
+            else
+            {
+                queries[i].x = anywhere(generator);
+                queries[i].y = anywhere(generator);
+            }
+        }
+
+        const size_t nb_points = nb_splines * ctrl_pts;
+        results.push_back(Measure(settings, "pick_linear_scan", "mixed", nb_points, nb_queries, [&]()
+            {
+                size_t nb_hits = 0;
+                for (const glm::vec2& query : queries)
+                {
+                    for (size_t i = 0; i < data.get_nb_splines(); ++i)
+                    {
+                        const auto points = data.get_points(i);
+                        auto near = [&](const glm::vec2& point) { return glm::length(query - point) < radius; };
+                        if (std::ranges::find_if(points, near) != points.end())
+                        {
+                            ++nb_hits;
+                            break;
+                        }
+                    }
+                }
+                sink = sink + static_cast<float>(nb_hits);
+            }));
+
+        results.push_back(Measure(settings, "pick_spatial_hash", "mixed", nb_points, nb_queries, [&]()
+            {
+                size_t nb_hits = 0;
+                for (const glm::vec2& query : queries)
+                {
+                    nb_hits += data.find_control_point(query, radius) ? 1 : 0;
+                }
+                sink = sink + static_cast<float>(nb_hits);
+            }));
+
+        // Drag of one point across the cells : the hash update, without the tessellation patch.
+        results.push_back(Measure(settings, "spatial_hash_move_point", "mixed", nb_points, nb_queries, [&]()
+            {
+                for (const glm::vec2& query : queries)
+                {
+                    data.control_points_hash.MovePoint(0, 0, query);
+                }
+            }));
+    }
+
+    // Closest point on curve against every segment of a dense scene, and the cost of the tree itself.
+    void BenchmarkClosestPoint
+    (
+        const settings& settings,
+        size_t nb_splines,
+        size_t nb_queries,
+        std::vector<result>& results
+    )
+    {
+        constexpr size_t ctrl_pts = 16;
+        constexpr float extent = 4096.f;
+
+        data data;
+        SceneGenerator::AddRandomSplines(data, 4, nb_splines, ctrl_pts, extent);
+        const size_t nb_segments = data.get_segments_bvh().GetSegments().size();
+
+        std::mt19937 generator(5);
+        std::uniform_real_distribution<float> anywhere(0.f, extent);
+        std::vector<glm::vec2> queries(nb_queries);
+        for (auto& query : queries)
+        {
+            query.x = anywhere(generator);
+            query.y = anywhere(generator);
+        }
+        std::vector<std::optional<SegmentBvh2d::ClosestPoint>> closest(nb_queries);
+
+        results.push_back(Measure(settings, "segment_bvh_build", "mixed", nb_splines * ctrl_pts, nb_segments, [&]()
+            {
+                data.segments_bvh_generation = UINT64_MAX;
+                sink = sink + static_cast<float>(data.get_segments_bvh().GetSegments().size());
+            }));
+
+        results.push_back(Measure(settings, "closest_curve_point", "mixed", nb_splines * ctrl_pts, nb_queries, [&]()
+            {
+                data.get_segments_bvh().FindClosest(queries, INFINITY, closest);
+                sink = sink + closest.back()->distance;
+            }));
+
+        // Hover : most queries have nothing within reach.
+        results.push_back(Measure(settings, "curve_hover_10px", "mixed", nb_splines * ctrl_pts, nb_queries, [&]()
+            {
+                data.get_segments_bvh().FindClosest(queries, 10.f, closest);
+                sink = sink + static_cast<float>(closest.back().has_value());
+            }));
+    }
+
+    // Every crossing between the splines of a dense scene, items are the splines.
+    void BenchmarkIntersections
+    (
+        const settings& settings,
+        size_t nb_splines,
+        std::vector<result>& results
+    )
+    {
+        constexpr size_t ctrl_pts = 16;
+        constexpr float tolerance = 0.01f;
+
+        data data;
+        SceneGenerator::AddRandomSplines(data, 7, nb_splines, ctrl_pts);
+        data.get_segments_bvh();
+
+        results.push_back(Measure(settings, "scene_intersections", "mixed", nb_splines * ctrl_pts, nb_splines, [&]()
+            {
+                sink = sink + static_cast<float>(data.find_intersections(tolerance).size());
+            }));
+    }
+
+    // Removal of random splines from a large scene, each one inserted back in its place as undo does.
+    void BenchmarkRemoveSpline
+    (
+        const settings& settings,
+        size_t nb_splines,
+        size_t ctrl_pts,
+        std::vector<result>& results
+    )
+    {
+        constexpr size_t nb_removals = 1000;
+
+        data data;
+        SceneGenerator::AddRandomSplines(data, 11, nb_splines, ctrl_pts);
+
+        std::mt19937 generator(11);
+        std::uniform_int_distribution<size_t> spline(0, nb_splines - 1);
+        std::vector<size_t> indices(nb_removals);
+        for (size_t& index : indices)
+        {
+            index = spline(generator);
+        }
+
+        std::vector<glm::vec2> points;
+        results.push_back(Measure(settings, "scene_remove_insert", "mixed", ctrl_pts, nb_removals, [&]()
+            {
+                for (size_t index : indices)
+                {
+                    const auto removed = data.get_points(index);
+                    points.assign(removed.begin(), removed.end());
+                    const spline_type type = data.splines_type[index];
+                    data.remove_spline(index);
+                    data.insert_spline(index, points, type);
+                }
+                sink = sink + static_cast<float>(data.get_nb_splines());
+            }));
+    }
+
+    // Fitting of a noisy trace of nb_points samples, items are the samples : least squares with a
+    // control point per 100 samples, and interpolation through all of them.
+    void BenchmarkFit
+    (
+        const settings& settings,
+        size_t nb_points,
+        std::vector<result>& results
+    )
+    {
+        std::vector<glm::vec2> points = SceneGenerator::RandomControlPoints(13, nb_points, 1.f);
+        std::mt19937 generator(13);
+        std::uniform_real_distribution<float> noise(-0.1f, 0.1f);
+        for (glm::vec2& point : points)
+        {
+            point += glm::vec2(noise(generator), noise(generator));
+        }
+
+        const size_t nb_ctrl_pts = nb_points / 100 + 4;
+        results.push_back(Measure(settings, "bspline_fit_least_squares", "bspline", nb_ctrl_pts, nb_points, [&]()
+            {
+                const auto ctrl_pts = BSplineFit::Approximate(points, nb_ctrl_pts, BSplineFit::Parameterization::CENTRIPETAL);
+                sink = sink + (ctrl_pts ? ctrl_pts->back().x : 0.f);
+            }));
+
+        results.push_back(Measure(settings, "bspline_fit_interpolation", "bspline", nb_points, nb_points, [&]()
+            {
+                const auto spline = BSplineFit::Interpolate(points, BSplineFit::Parameterization::CHORD_LENGTH);
+                sink = sink + (spline ? spline->m_ctrl_pts[1].x : 0.f);
+            }));
+    }
+
+    // Builds the tessellated scene into an ImGui draw list, in a frame of a context without backend :
+    // one ImDrawList call per sample as the editor used to, against the batched builder and against
+    // emitting the geometry kept from a previous frame.
+    void BenchmarkDrawList
+    (
+        const settings& settings,
+        size_t nb_splines,
+        size_t ctrl_pts,
+        std::vector<result>& results
+    )
+    {
+        data data;
+        SceneGenerator::AddRandomSplines(data, 6, nb_splines, ctrl_pts);
+        std::vector<std::span<const glm::vec2>> polylines;
+        size_t nb_samples = 0;
+        for (size_t i = 0; i < nb_splines; ++i)
+        {
+            polylines.push_back(data.get_tessellation(i));
+            nb_samples += polylines.back().size();
+        }
+
+        ImGui::CreateContext();
+        ImGuiIO& io = ImGui::GetIO();
+        io.DisplaySize = ImVec2(1280.f, 720.f);
+        io.DeltaTime = 1.f / 60.f;
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+        io.IniFilename = nullptr;
+
+        DrawListBuilder builder;
+        builder.Bake(io.Fonts);
+
+        auto frame = [&](auto&& draw)
+            {
+                ImGui::NewFrame();
+                ImGui::SetNextWindowPos(ImVec2(0.f, 0.f));
+                ImGui::SetNextWindowSize(io.DisplaySize);
+                ImGui::Begin("canvas");
+                draw(ImGui::GetWindowDrawList());
+                ImGui::End();
+                ImGui::Render();
+                sink = sink + static_cast<float>(ImGui::GetDrawData()->TotalVtxCount);
+            };
+
+        results.push_back(Measure(settings, "draw_list_immediate", "mixed", ctrl_pts, nb_samples, [&]()
+            {
+                frame([&](ImDrawList* draw_list)
+                    {
+                        for (const auto& points : polylines)
+                        {
+                            for (size_t n = 0; n + 1 < points.size(); n++)
+                            {
+                                draw_list->AddLine({ points[n].x, points[n].y }, { points[n + 1].x, points[n + 1].y }, IM_COL32(255, 255, 0, 255), 2.0f);
+                                draw_list->AddCircleFilled({ points[n].x, points[n].y }, 3, IM_COL32(255, 0, 0, 255));
+                            }
+                            draw_list->AddCircleFilled({ points.back().x, points.back().y }, 3, IM_COL32(255, 0, 0, 255));
+                        }
+                    });
+            }));
+
+        results.push_back(Measure(settings, "draw_list_batched", "mixed", ctrl_pts, nb_samples, [&]()
+            {
+                frame([&](ImDrawList* draw_list)
+                    {
+                        builder.Clear();
+                        for (const auto& points : polylines)
+                        {
+                            builder.AddPolyline(points, false);
+                        }
+                        builder.Emit(draw_list, glm::vec2(0.f));
+                    });
+            }));
+
+        results.push_back(Measure(settings, "draw_list_cached", "mixed", ctrl_pts, nb_samples, [&]()
+            {
+                frame([&](ImDrawList* draw_list) { builder.Emit(draw_list, glm::vec2(0.f)); });
+            }));
+
+        ImGui::DestroyContext();
+    }
+
+    void WriteJson(std::ostream& out, const settings& settings, const std::vector<result>& results)
+    {
+#ifdef SPLINE_USE_SSE2
+        constexpr bool sse2 = true;
+#else
+        constexpr bool sse2 = false;
+#endif
+#ifdef NDEBUG
+        constexpr bool assertions = false;
+#else
+        constexpr bool assertions = true;
+#endif
+
+        out << "{\n";
+        out << "  \"context\": {\n";
+        out << "    \"sse2\": " << (sse2 ? "true" : "false") << ",\n";
+        out << "    \"assertions\": " << (assertions ? "true" : "false") << ",\n";
+        out << "    \"min_time\": " << settings.min_time << ",\n";
+        out << "    \"threads\": " << settings.threads << ",\n";
+        out << "    \"max_ctrl_pts\": " << settings.max_ctrl_pts << "\n";
+        out << "  },\n";
+        out << "  \"results\": [\n";
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const result& r = results[i];
+            const double items = static_cast<double>(r.iterations * r.items);
+            out << "    { ";
+            out << "\"benchmark\": \"" << r.benchmark << "\", ";
+            out << "\"spline_type\": \"" << r.spline_type << "\", ";
+            out << "\"ctrl_pts\": " << r.ctrl_pts << ", ";
+            out << "\"items\": " << r.items << ", ";
+            out << "\"iterations\": " << r.iterations << ", ";
+            out << "\"seconds\": " << r.seconds << ", ";
+            out << "\"ns_per_item\": " << 1e9 * r.seconds / items << ", ";
+            out << "\"items_per_second\": " << items / r.seconds;
+            out << (i + 1 < results.size() ? " },\n" : " }\n");
+        }
+        out << "  ]\n";
+        out << "}\n";
+    }
+
+    bool ParseArguments(int argc, char** argv, settings& settings)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view argument = argv[i];
+            const bool has_value = i + 1 < argc;
+            if (argument == "--quick")
+            {
+                settings.max_ctrl_pts = 4096;
+                settings.min_time = 0.02;
+                settings.quick = true;
+            }
+            else if (argument == "--max-ctrl-pts" && has_value)
+            {
+                settings.max_ctrl_pts = std::strtoull(argv[++i], nullptr, 10);
+            }
+            else if (argument == "--min-time" && has_value)
+            {
+                settings.min_time = std::strtod(argv[++i], nullptr);
+            }
+            else if (argument == "--threads" && has_value)
+            {
+                settings.threads = std::max<size_t>(std::strtoull(argv[++i], nullptr, 10), 1);
+            }
+            else if (argument == "--output" && has_value)
+            {
+                settings.output = argv[++i];
+            }
+            else
+            {
+                std::fprintf(stderr, "usage: %s [--quick] [--max-ctrl-pts N] [--min-time SECONDS] [--threads N] [--output FILE]\n", argv[0]);
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    settings settings;
+    if (!ParseArguments(argc, argv, settings))
+    {
+        return EXIT_FAILURE;
+    }
+
+    std::vector<result> results;
+    for (size_t ctrl_pts = 4; ctrl_pts <= settings.max_ctrl_pts; ctrl_pts *= 4)
+    {
+        BenchmarkSpline<CubicBezierSpline2d>(settings, "bezier", ctrl_pts, results);
+        BenchmarkSpline<CubicHermiteSpline2d>(settings, "hermite", ctrl_pts, results);
+        BenchmarkSpline<CubicBSpline2d>(settings, "bspline", ctrl_pts, results);
+        BenchmarkTemplateSpline<QuadraticBSpline2d>(settings, "bspline2f", ctrl_pts, results);
+        BenchmarkTemplateSpline<BSpline<3, 2, float>>(settings, "bspline_f", ctrl_pts, results);
+        BenchmarkTemplateSpline<CubicBSpline3d>(settings, "bspline3d", ctrl_pts, results);
+    }
+    BenchmarkScene(settings, 1000, 64, results);
+    BenchmarkParallelScene(settings, settings.quick ? 1000 : 100000, 16, results);
+    BenchmarkSceneFile(settings, settings.quick ? 10000 : 100000, 64, results);
+    BenchmarkSvgImport(settings, settings.quick ? 1000 : 10000, 64, results);
+    BenchmarkPicking(settings, 1024, std::clamp<size_t>(settings.max_ctrl_pts / 1024, 4, 1024), results);
+    BenchmarkClosestPoint(settings, settings.quick ? 1000 : 10000, settings.quick ? 10000 : 100000, results);
+    BenchmarkIntersections(settings, settings.quick ? 1000 : 10000, results);
+    BenchmarkRemoveSpline(settings, settings.quick ? 10000 : 100000, 16, results);
+    for (size_t nb_points = 1000; nb_points <= (settings.quick ? 10000u : 1000000u); nb_points *= 10)
+    {
+        BenchmarkFit(settings, nb_points, results);
+    }
+    BenchmarkDrawList(settings, settings.quick ? 100 : 1000, 64, results);
+
+    if (settings.output)
+    {
+        std::ofstream file(settings.output);
+        if (!file)
+        {
+            std::fprintf(stderr, "cannot open %s\n", settings.output);
+            return EXIT_FAILURE;
+        }
+        WriteJson(file, settings, results);
+    }
+    else
+    {
+        WriteJson(std::cout, settings, results);
+    }
+
+    return EXIT_SUCCESS;
+}
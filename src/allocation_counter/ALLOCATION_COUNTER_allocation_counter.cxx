@@ -0,0 +1,55 @@
+#include "../allocation_counter/allocation_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<uint64_t> nb_allocations = 0;
+}
+
+// The array and nothrow forms call these ones.
+void* operator new(size_t size)
+{
+    nb_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+uint64_t AllocationCounter::GetNbAllocations()
+{
+    return nb_allocations.load(std::memory_order_relaxed);
+}
+
+void* AllocationCounter::Malloc
+(
+    size_t size,
+    void*
+)
+{
+    nb_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size);
+}
+
+void AllocationCounter::Free
+(
+    void* ptr,
+    void*
+)
+{
+    std::free(ptr);
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Number of global heap allocations since the start of the program, to check that a frame does
+// not allocate. The global operator new is replaced to count them, over-aligned allocations are
+// left to the default one and not counted.
+namespace AllocationCounter
+{
+    uint64_t GetNbAllocations();
+
+    // Counting malloc and free, with the signatures of ImGui::SetAllocatorFunctions.
+    void* Malloc(size_t size, void* user_data);
+    void Free(void* ptr, void* user_data);
+};
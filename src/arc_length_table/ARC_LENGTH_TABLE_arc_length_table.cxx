@@ -0,0 +1,202 @@
+#include "../arc_length_table/arc_length_table.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+namespace
+{
+    // 5 points Gauss-Legendre rule on [-1, 1].
+    constexpr std::array<double, 5> gauss_nodes = { -0.9061798459386640, -0.5384693101056831, 0.0, 0.5384693101056831, 0.9061798459386640 };
+    constexpr std::array<double, 5> gauss_weights = { 0.2369268850561891, 0.4786286704993665, 0.5688888888888889, 0.4786286704993665, 0.2369268850561891 };
+
+    constexpr int max_newton_iterations = 8;
+    constexpr double parameter_tolerance = 1e-12;
+
+    // Norm of dC/dt. Bezier and Hermite derivatives are given with respect to the curve
+    // parameter, which runs nb_curves times faster than t.
+    double Speed(const CubicBezierSpline2d& spline, double t)
+    {
+        return glm::length(glm::dvec2(spline.EvalFirstDerivative(t))) * static_cast<double>(spline.m_curves.size());
+    }
+
+    double Speed(const CubicHermiteSpline2d& spline, double t)
+    {
+        return glm::length(glm::dvec2(spline.EvalFirstDerivative(t))) * static_cast<double>(spline.m_curves.size());
+    }
+
+    double Speed(const CubicBSpline2d& spline, double t)
+    {
+        return glm::length(glm::dvec2(spline.EvalFirstDerivative(t)));
+    }
+
+    // Parameters where the spline pieces join.
+    std::vector<double> Breakpoints(const CubicBezierSpline2d& spline)
+    {
+        std::vector<double> breakpoints(spline.m_curves.size() + 1);
+        for (size_t i = 0; i < breakpoints.size(); ++i)
+        {
+            breakpoints[i] = static_cast<double>(i) / static_cast<double>(spline.m_curves.size());
+        }
+        return breakpoints;
+    }
+
+    std::vector<double> Breakpoints(const CubicHermiteSpline2d& spline)
+    {
+        std::vector<double> breakpoints(spline.m_curves.size() + 1);
+        for (size_t i = 0; i < breakpoints.size(); ++i)
+        {
+            breakpoints[i] = static_cast<double>(i) / static_cast<double>(spline.m_curves.size());
+        }
+        return breakpoints;
+    }
+
+    std::vector<double> Breakpoints(const CubicBSpline2d& spline)
+    {
+        std::vector<double> breakpoints(spline.m_knots.begin() + 3, spline.m_knots.end() - 3);
+        breakpoints.erase(std::unique(breakpoints.begin(), breakpoints.end()), breakpoints.end());
+        return breakpoints;
+    }
+
+    template <class Spline>
+    double Integrate(const Spline& spline, double a, double b)
+    {
+        const double half_width = 0.5 * (b - a);
+        const double center = 0.5 * (a + b);
+
+        double length = 0.0;
+        for (size_t i = 0; i < gauss_nodes.size(); ++i)
+        {
+            length += gauss_weights[i] * Speed(spline, center + half_width * gauss_nodes[i]);
+        }
+        return length * half_width;
+    }
+}
+
+template <class Spline>
+ArcLengthTable<Spline>::ArcLengthTable(Spline spline, size_t nb_subdivisions)
+    : m_spline(std::move(spline))
+{
+    assert(nb_subdivisions > 0);
+
+    std::vector<double> breakpoints = Breakpoints(m_spline);
+    m_parameters.reserve((breakpoints.size() - 1) * nb_subdivisions + 1);
+    for (size_t i = 0; i + 1 < breakpoints.size(); ++i)
+    {
+        const double step = (breakpoints[i + 1] - breakpoints[i]) / static_cast<double>(nb_subdivisions);
+        for (size_t j = 0; j < nb_subdivisions; ++j)
+        {
+            m_parameters.push_back(breakpoints[i] + static_cast<double>(j) * step);
+        }
+    }
+    m_parameters.push_back(breakpoints.back());
+
+    m_lengths.resize(m_parameters.size());
+    m_lengths[0] = 0.0;
+    for (size_t i = 1; i < m_parameters.size(); ++i)
+    {
+        m_lengths[i] = m_lengths[i - 1] + Integrate(m_spline, m_parameters[i - 1], m_parameters[i]);
+    }
+}
+
+template <class Spline>
+double ArcLengthTable<Spline>::GetLength() const
+{
+    return m_lengths.back();
+}
+
+template <class Spline>
+double ArcLengthTable<Spline>::GetArcLength(double t) const
+{
+    t = std::clamp(t, m_parameters.front(), m_parameters.back());
+
+    auto it = std::upper_bound(m_parameters.begin(), m_parameters.end(), t);
+    size_t interval = std::min(static_cast<size_t>(std::distance(m_parameters.begin(), it)), m_parameters.size() - 1) - 1;
+
+    return m_lengths[interval] + Integrate(m_spline, m_parameters[interval], t);
+}
+
+template <class Spline>
+double ArcLengthTable<Spline>::GetParameter(double s) const
+{
+    s = std::clamp(s, 0.0, GetLength());
+
+    auto it = std::upper_bound(m_lengths.begin(), m_lengths.end(), s);
+    size_t interval = std::min(static_cast<size_t>(std::distance(m_lengths.begin(), it)), m_lengths.size() - 1) - 1;
+
+    return GetParameter(s, interval);
+}
+
+template <class Spline>
+void ArcLengthTable<Spline>::GetParameters(std::span<const double> s, std::span<double> t) const
+{
+    assert(s.size() == t.size());
+
+    size_t interval = 0;
+    for (size_t i = 0; i < s.size(); ++i)
+    {
+        const double si = std::clamp(s[i], 0.0, GetLength());
+        if (si < m_lengths[interval])
+        {
+            t[i] = GetParameter(si);
+            continue;
+        }
+        while (interval + 2 < m_lengths.size() && m_lengths[interval + 1] <= si)
+        {
+            ++interval;
+        }
+        t[i] = GetParameter(si, interval);
+    }
+}
+
+template <class Spline>
+double ArcLengthTable<Spline>::GetParameter(double s, size_t interval) const
+{
+    double t_min = m_parameters[interval];
+    double t_max = m_parameters[interval + 1];
+    const double s_min = m_lengths[interval];
+    const double s_max = m_lengths[interval + 1];
+    if (s_max - s_min <= 0.0)
+    {
+        return t_min;
+    }
+
+    // Newton's method on s(t) - s, kept inside the bracket by falling back on bisection.
+    double t = t_min + (t_max - t_min) * (s - s_min) / (s_max - s_min);
+    for (int i = 0; i < max_newton_iterations; ++i)
+    {
+        const double f = s_min + Integrate(m_spline, m_parameters[interval], t) - s;
+        if (f == 0.0)
+        {
+            return t;
+        }
+        if (f > 0.0)
+        {
+            t_max = t;
+        }
+        else
+        {
+            t_min = t;
+        }
+
+        const double speed = Speed(m_spline, t);
+        if (speed > 0.0 && std::abs(f) < parameter_tolerance * speed)
+        {
+            return t;
+        }
+
+        double next = speed > 0.0 ? t - f / speed : t_min;
+        if (next <= t_min || next >= t_max)
+        {
+            next = 0.5 * (t_min + t_max);
+        }
+        t = next;
+    }
+    return t;
+}
+
+template class ArcLengthTable<CubicBezierSpline2d>;
+template class ArcLengthTable<CubicHermiteSpline2d>;
+template class ArcLengthTable<CubicBSpline2d>;
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <span>
+#include <vector>
+
+#include "../cubic_bezier_spline_2d/cubic_bezier_spline_2d.h"
+#include "../cubic_hermite_spline_2d/cubic_hermite_spline_2d.h"
+#include "../cubic_bspline_2d/cubic_bspline_2d.h"
+
+// Cumulative arc length of a spline at the bounds of its pieces, each piece split in
+// nb_subdivisions intervals integrated by Gauss-Legendre quadrature. Instantiated for
+// CubicBezierSpline2d, CubicHermiteSpline2d and CubicBSpline2d. The table keeps its own copy of
+// the spline and must be rebuilt when the original changes.
+template <class Spline>
+class ArcLengthTable
+{
+public:
+    explicit ArcLengthTable(Spline spline, size_t nb_subdivisions = 4);
+
+    double GetLength() const;
+
+    // s(t), by quadrature from the closest tabulated parameter.
+    double GetArcLength(double t) const;
+
+    // t(s), the tabulated interval is found by binary search then refined by Newton's method
+    // on the spline first derivative.
+    double GetParameter(double s) const;
+
+    // t(s) for every s, sorted inputs walk the table instead of searching it.
+    void GetParameters(std::span<const double> s, std::span<double> t) const;
+
+    Spline m_spline;
+    std::vector<double> m_parameters;
+    std::vector<double> m_lengths;
+
+private:
+    double GetParameter(double s, size_t interval) const;
+};
@@ -0,0 +1,5 @@
+#include "../bezier/bezier.h"
+
+template class Bezier<2, 2, float>;
+template class Bezier<3, 2, float>;
+template class Bezier<3, 3, float>;
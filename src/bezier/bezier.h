@@ -0,0 +1,188 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <utility>
+
+// Pascal's triangle up to row N : BinomialTable<N>()[n][k] = C(n, k).
+template <size_t N>
+constexpr std::array< std::array< size_t, N + 1 >, N + 1 > BinomialTable()
+{
+    std::array< std::array< size_t, N + 1 >, N + 1 > table{};
+    for (size_t n = 0; n <= N; ++n)
+    {
+        table[n][0] = 1;
+        for (size_t k = 1; k <= n; ++k)
+        {
+            table[n][k] = table[n - 1][k - 1] + (k < n ? table[n - 1][k] : 0);
+        }
+    }
+    return table;
+}
+
+// Bezier curve of any degree, dimension and scalar type. Every loop runs over the Degree + 1
+// control points, known at compile time, so that the compiler unrolls them.
+template <size_t Degree, size_t Dim, class T>
+class Bezier
+{
+public:
+    using scalar = T;
+    using point = glm::vec<static_cast<glm::length_t>(Dim), T>;
+
+    static constexpr size_t degree = Degree;
+    static constexpr size_t order = Degree + 1;
+
+    // Binomial coefficients C(Degree, i) of the Bernstein polynomials.
+    static constexpr std::array< T, order > binomials = []()
+        {
+            std::array< T, order > row{};
+            for (size_t i = 0; i < order; ++i)
+            {
+                row[i] = static_cast<T>(BinomialTable<Degree>()[Degree][i]);
+            }
+            return row;
+        }();
+
+    // basis_matrix[i][j] is the coefficient of u^j in the Bernstein polynomial of P[i] :
+    // C(Degree, i) C(Degree - i, j - i) (-1)^(j - i) for j >= i.
+    static constexpr std::array< std::array< T, order >, order > basis_matrix = []()
+        {
+            constexpr auto table = BinomialTable<Degree>();
+            std::array< std::array< T, order >, order > matrix{};
+            for (size_t i = 0; i < order; ++i)
+            {
+                for (size_t j = i; j < order; ++j)
+                {
+                    const auto coefficient = static_cast<T>(table[Degree][i] * table[Degree - i][j - i]);
+                    matrix[i][j] = (j - i) % 2 == 0 ? coefficient : -coefficient;
+                }
+            }
+            return matrix;
+        }();
+
+    Bezier() = default;
+
+    explicit Bezier(const std::array< point, order >& ctrl_pts)
+        : P(ctrl_pts)
+    {
+    }
+
+    point Eval(T u) const
+    {
+        std::array< T, order > u_powers;
+        std::array< T, order > v_powers;
+        u_powers[0] = T(1);
+        v_powers[0] = T(1);
+        for (size_t i = 1; i < order; ++i)
+        {
+            u_powers[i] = u_powers[i - 1] * u;
+            v_powers[i] = v_powers[i - 1] * (T(1) - u);
+        }
+
+        point p(T(0));
+        for (size_t i = 0; i < order; ++i)
+        {
+            p += (binomials[i] * u_powers[i] * v_powers[Degree - i]) * P[i];
+        }
+        return p;
+    }
+
+    // Horner's scheme on the power basis coefficients, the same operations for every parameter.
+    void Eval(std::span<const T> u, std::span<point> pts) const
+    {
+        assert(u.size() == pts.size());
+
+        const std::array< point, order > C = GetPowerCoefficients();
+        for (size_t k = 0; k < u.size(); ++k)
+        {
+            point p = C[Degree];
+            for (size_t j = Degree; j-- > 0;)
+            {
+                p = p * u[k] + C[j];
+            }
+            pts[k] = p;
+        }
+    }
+
+    // Coefficients C[j] of u^j.
+    std::array< point, order > GetPowerCoefficients() const
+    {
+        std::array< point, order > C;
+        for (size_t j = 0; j < order; ++j)
+        {
+            C[j] = point(T(0));
+            for (size_t i = 0; i <= j; ++i)
+            {
+                C[j] += basis_matrix[i][j] * P[i];
+            }
+        }
+        return C;
+    }
+
+    // Hodograph : Degree (P[i + 1] - P[i]).
+    Bezier<Degree - 1, Dim, T> Derivative() const requires (Degree >= 1)
+    {
+        Bezier<Degree - 1, Dim, T> derivative;
+        for (size_t i = 0; i < Degree; ++i)
+        {
+            derivative.P[i] = static_cast<T>(Degree) * (P[i + 1] - P[i]);
+        }
+        return derivative;
+    }
+
+    point EvalFirstDerivative(T u) const requires (Degree >= 1)
+    {
+        return Derivative().Eval(u);
+    }
+
+    point EvalSecondDerivative(T u) const requires (Degree >= 2)
+    {
+        return Derivative().Derivative().Eval(u);
+    }
+
+    // Same curve as one degree higher, e.g. quadratic glyph outlines as cubics.
+    Bezier<Degree + 1, Dim, T> Elevate() const
+    {
+        Bezier<Degree + 1, Dim, T> elevated;
+        elevated.P[0] = P[0];
+        elevated.P[Degree + 1] = P[Degree];
+        for (size_t i = 1; i <= Degree; ++i)
+        {
+            const T a = static_cast<T>(i) / static_cast<T>(Degree + 1);
+            elevated.P[i] = a * P[i - 1] + (T(1) - a) * P[i];
+        }
+        return elevated;
+    }
+
+    // de Casteljau split at u into the curves over [0, u] and [u, 1].
+    std::pair< Bezier, Bezier > Subdivide(T u) const
+    {
+        std::array< point, order > d = P;
+        Bezier left;
+        Bezier right;
+        left.P[0] = P[0];
+        right.P[Degree] = P[Degree];
+        for (size_t r = 1; r < order; ++r)
+        {
+            for (size_t i = 0; i + r < order; ++i)
+            {
+                d[i] = glm::mix(d[i], d[i + 1], u);
+            }
+            left.P[r] = d[0];
+            right.P[Degree - r] = d[Degree - r];
+        }
+        return { left, right };
+    }
+
+    std::array< point, order > P;
+};
+
+using QuadraticBezierCurve2d = Bezier<2, 2, float>;
+using CubicBezierCurve3d = Bezier<3, 3, float>;
+
+extern template class Bezier<2, 2, float>;
+extern template class Bezier<3, 2, float>;
+extern template class Bezier<3, 3, float>;
@@ -0,0 +1,32 @@
+#include "../bounding_box_2d/bounding_box_2d.h"
+
+BoundingBox2d::BoundingBox2d(const glm::vec2& min, const glm::vec2& max)
+    : min(min)
+    , max(max)
+{
+}
+
+BoundingBox2d BoundingBox2d::FromPoints(std::span<const glm::vec2> points)
+{
+    BoundingBox2d box;
+    for (const glm::vec2& point : points)
+    {
+        box.Extend(point);
+    }
+    return box;
+}
+
+glm::vec2 BoundingBox2d::GetCenter() const
+{
+    return 0.5f * (min + max);
+}
+
+glm::vec2 BoundingBox2d::GetSize() const
+{
+    return max - min;
+}
+
+BoundingBox2d BoundingBox2d::Inflated(float margin) const
+{
+    return BoundingBox2d(min - glm::vec2(margin), max + glm::vec2(margin));
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cmath>
+#include <span>
+
+// Axis aligned box, empty when default constructed : min > max until a point is added.
+class BoundingBox2d
+{
+public:
+    BoundingBox2d() = default;
+    BoundingBox2d(const glm::vec2& min, const glm::vec2& max);
+
+    static BoundingBox2d FromPoints(std::span<const glm::vec2> points);
+
+    void Extend(const glm::vec2& point)
+    {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+
+    void Extend(const BoundingBox2d& box)
+    {
+        min = glm::min(min, box.min);
+        max = glm::max(max, box.max);
+    }
+
+    bool IsEmpty() const
+    {
+        return min.x > max.x || min.y > max.y;
+    }
+
+    bool Contains(const glm::vec2& point) const
+    {
+        return min.x <= point.x && point.x <= max.x && min.y <= point.y && point.y <= max.y;
+    }
+
+    bool Contains(const BoundingBox2d& box) const
+    {
+        return min.x <= box.min.x && box.max.x <= max.x && min.y <= box.min.y && box.max.y <= max.y;
+    }
+
+    bool Overlaps(const BoundingBox2d& box) const
+    {
+        return min.x <= box.max.x && box.min.x <= max.x && min.y <= box.max.y && box.min.y <= max.y;
+    }
+
+    // Squared distance from point to the box, 0 inside.
+    float DistanceSquared(const glm::vec2& point) const
+    {
+        const glm::vec2 d = glm::max(glm::max(min - point, point - max), glm::vec2(0.f));
+        return glm::dot(d, d);
+    }
+
+    glm::vec2 GetCenter() const;
+    glm::vec2 GetSize() const;
+    BoundingBox2d Inflated(float margin) const;
+
+    bool operator==(const BoundingBox2d& box) const = default;
+
+    glm::vec2 min = { INFINITY, INFINITY };
+    glm::vec2 max = { -INFINITY, -INFINITY };
+};
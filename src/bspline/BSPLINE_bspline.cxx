@@ -0,0 +1,6 @@
+#include "../bspline/bspline.h"
+
+template class BSpline<2, 2, float>;
+template class BSpline<3, 2, float>;
+template class BSpline<3, 3, float>;
+template class BSpline<3, 2, float, double>;
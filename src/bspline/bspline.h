@@ -0,0 +1,258 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "../bezier/bezier.h"
+
+// Knot span algorithms shared by the B-spline classes, for any degree, point and knot type.
+namespace BSplineBasis
+{
+    // Clamped knot vector on [0, 1] : Degree + 1 zeros and ones around uniform interior knots.
+    template <class Knot>
+    std::vector<Knot> ClampedUniformKnots(size_t degree, size_t nb_ctrl_pts)
+    {
+        assert(nb_ctrl_pts > degree);
+
+        std::vector<Knot> knots(nb_ctrl_pts + degree + 1, Knot(0));
+        const auto denominator = static_cast<Knot>(nb_ctrl_pts - degree);
+        for (size_t k = 1; k < nb_ctrl_pts - degree; ++k)
+        {
+            knots[degree + k] = static_cast<Knot>(k) / denominator;
+        }
+        std::fill(knots.end() - static_cast<std::ptrdiff_t>(degree + 1), knots.end(), Knot(1));
+        return knots;
+    }
+
+    // de Boor's triangular scheme on the Degree + 1 control points active on
+    // knots[span], knots[span + 1]. d[j] holds the control point span - Degree + j.
+    template <size_t Degree, class Point, class Knot>
+    Point DeBoor(Knot u, size_t span, std::array< Point, Degree + 1 > d, const Knot* knots)
+    {
+        using scalar = typename Point::value_type;
+        const Knot epsilon = std::numeric_limits<Knot>::epsilon();
+        for (size_t r = 1; r <= Degree; ++r)
+        {
+            for (size_t j = Degree; j >= r; --j)
+            {
+                size_t i = span - Degree + j;
+                Knot D = knots[i + Degree + 1 - r] - knots[i];
+                auto alpha = static_cast<scalar>(D < epsilon ? Knot(0) : (u - knots[i]) / D);
+                d[j] = (scalar(1) - alpha) * d[j - 1] + alpha * d[j];
+            }
+        }
+        return d[Degree];
+    }
+
+    // Polar form f(u[0], ..., u[Degree - 1]) of the curve on span : de Boor's scheme with one parameter per level.
+    template <size_t Degree, class Point, class Knot>
+    Point Blossom(const std::array< Knot, Degree >& u, size_t span, std::array< Point, Degree + 1 > d, const Knot* knots)
+    {
+        using scalar = typename Point::value_type;
+        const Knot epsilon = std::numeric_limits<Knot>::epsilon();
+        for (size_t r = 1; r <= Degree; ++r)
+        {
+            for (size_t j = Degree; j >= r; --j)
+            {
+                size_t i = span - Degree + j;
+                Knot D = knots[i + Degree + 1 - r] - knots[i];
+                auto alpha = static_cast<scalar>(D < epsilon ? Knot(0) : (u[r - 1] - knots[i]) / D);
+                d[j] = (scalar(1) - alpha) * d[j - 1] + alpha * d[j];
+            }
+        }
+        return d[Degree];
+    }
+
+    // Control points of the derivative of a spline of the given degree :
+    // Q_i = deg * (P_i+1 - P_i) / (u_i+deg+1 - u_i+1), for the Degree points active on span.
+    template <size_t Degree, class Point, class Knot>
+    std::array< Point, Degree > Derive(size_t span, const std::array< Point, Degree + 1 >& d, const Knot* knots)
+    {
+        using scalar = typename Point::value_type;
+        const Knot epsilon = std::numeric_limits<Knot>::epsilon();
+        std::array< Point, Degree > q;
+        for (size_t j = 0; j < Degree; ++j)
+        {
+            size_t i = span - Degree + j;
+            Knot D = knots[i + Degree + 1] - knots[i + 1];
+            q[j] = D < epsilon ? Point(scalar(0)) : static_cast<scalar>(static_cast<Knot>(Degree) / D) * (d[j + 1] - d[j]);
+        }
+        return q;
+    }
+}
+
+// B-spline of any degree, dimension and scalar type on a clamped knot vector, uniform by default.
+// Knots may be of a wider type than the control points, as CubicBSpline2d's double ones.
+template <size_t Degree, size_t Dim, class T, class Knot = T>
+class BSpline
+{
+public:
+    using scalar = T;
+    using knot = Knot;
+    using point = glm::vec<static_cast<glm::length_t>(Dim), T>;
+
+    static constexpr size_t degree = Degree;
+
+    explicit BSpline(std::span<const point> ctrl_pts)
+        : m_ctrl_pts(ctrl_pts.begin(), ctrl_pts.end())
+        , m_knots(BSplineBasis::ClampedUniformKnots<Knot>(Degree, ctrl_pts.size()))
+    {
+    }
+
+    // Clamped knots on [0, 1], ctrl_pts.size() + Degree + 1 of them.
+    BSpline(std::span<const point> ctrl_pts, std::vector<Knot> knots)
+        : m_ctrl_pts(ctrl_pts.begin(), ctrl_pts.end())
+        , m_knots(std::move(knots))
+    {
+        assert(m_ctrl_pts.size() > Degree && m_knots.size() == m_ctrl_pts.size() + Degree + 1);
+    }
+
+    // Index k of the knot span [m_knots[k], m_knots[k + 1]) containing t, for k in [Degree, n - 1],
+    // the last one closed.
+    size_t FindSpan(Knot t) const
+    {
+        const size_t last_span = m_ctrl_pts.size() - 1;
+        if (t >= m_knots[last_span + 1])
+        {
+            return last_span;
+        }
+
+        auto first = m_knots.begin() + static_cast<std::ptrdiff_t>(Degree + 1);
+        auto last = m_knots.begin() + static_cast<std::ptrdiff_t>(last_span + 1);
+        auto it = std::upper_bound(first, last, t);
+        return static_cast<size_t>(std::distance(m_knots.begin(), it)) - 1;
+    }
+
+    std::array< point, Degree + 1 > GetSpanControlPoints(size_t span) const
+    {
+        std::array< point, Degree + 1 > d;
+        std::copy_n(m_ctrl_pts.begin() + static_cast<std::ptrdiff_t>(span - Degree), Degree + 1, d.begin());
+        return d;
+    }
+
+    // Bezier form of the curve over the span : its control point i is the blossom of
+    // Degree - i times the span start and i times the span end.
+    Bezier<Degree, Dim, T> GetSpanBezier(size_t span) const
+    {
+        const std::array< point, Degree + 1 > d = GetSpanControlPoints(span);
+        Bezier<Degree, Dim, T> bezier;
+        for (size_t i = 0; i <= Degree; ++i)
+        {
+            std::array< Knot, Degree > u;
+            std::fill_n(u.begin(), Degree - i, m_knots[span]);
+            std::fill(u.begin() + static_cast<std::ptrdiff_t>(Degree - i), u.end(), m_knots[span + 1]);
+            bezier.P[i] = BSplineBasis::Blossom<Degree>(u, span, d, m_knots.data());
+        }
+        return bezier;
+    }
+
+    point Eval(Knot t) const
+    {
+        // NaN as well, it has no span.
+        if (!(t > Knot(0)))
+        {
+            return m_ctrl_pts.front();
+        }
+        if (t >= Knot(1))
+        {
+            return m_ctrl_pts.back();
+        }
+
+        const size_t span = FindSpan(t);
+        return BSplineBasis::DeBoor<Degree>(t, span, GetSpanControlPoints(span), m_knots.data());
+    }
+
+    // Parameters are grouped in runs on the same knot span. Long runs, as sorted parameters make,
+    // are evaluated by Horner's scheme on the power form of the span ; short ones by de Boor's.
+    void Eval(std::span<const Knot> t, std::span<point> pts) const
+    {
+        assert(t.size() == pts.size());
+
+        size_t span = 0;
+        size_t i = 0;
+        while (i < t.size())
+        {
+            if (!(t[i] > Knot(0)) || t[i] >= Knot(1))
+            {
+                pts[i] = t[i] >= Knot(1) ? m_ctrl_pts.back() : m_ctrl_pts.front();
+                ++i;
+                continue;
+            }
+
+            const bool is_on_next_span = span != 0 && span + 1 < m_ctrl_pts.size() && m_knots[span + 1] <= t[i] && t[i] < m_knots[span + 2];
+            span = is_on_next_span ? span + 1 : FindSpan(t[i]);
+            const Knot start = m_knots[span];
+            const Knot end = m_knots[span + 1];
+
+            size_t count = 1;
+            while (i + count < t.size() && start <= t[i + count] && t[i + count] < end)
+            {
+                ++count;
+            }
+
+            if (count <= Degree)
+            {
+                const std::array< point, Degree + 1 > d = GetSpanControlPoints(span);
+                for (size_t k = i; k < i + count; ++k)
+                {
+                    pts[k] = BSplineBasis::DeBoor<Degree>(t[k], span, d, m_knots.data());
+                }
+            }
+            else
+            {
+                const std::array< point, Degree + 1 > C = GetSpanBezier(span).GetPowerCoefficients();
+                const Knot scale = Knot(1) / (end - start);
+                for (size_t k = i; k < i + count; ++k)
+                {
+                    const auto u = static_cast<T>((t[k] - start) * scale);
+                    point p = C[Degree];
+                    for (size_t j = Degree; j-- > 0;)
+                    {
+                        p = p * u + C[j];
+                    }
+                    pts[k] = p;
+                }
+            }
+            i += count;
+        }
+    }
+
+    // The derivative is a B-spline of degree Degree - 1 on the knots without their first and last values.
+    point EvalFirstDerivative(Knot t) const requires (Degree >= 1)
+    {
+        t = std::clamp(t, Knot(0), Knot(1));
+
+        const size_t span = FindSpan(t);
+        const std::array< point, Degree > Q = BSplineBasis::Derive<Degree>(span, GetSpanControlPoints(span), m_knots.data());
+        return BSplineBasis::DeBoor<Degree - 1>(t, span - 1, Q, m_knots.data() + 1);
+    }
+
+    // Derived twice, on the knots without their first two and last two values.
+    point EvalSecondDerivative(Knot t) const requires (Degree >= 2)
+    {
+        t = std::clamp(t, Knot(0), Knot(1));
+
+        const size_t span = FindSpan(t);
+        const std::array< point, Degree > Q = BSplineBasis::Derive<Degree>(span, GetSpanControlPoints(span), m_knots.data());
+        const std::array< point, Degree - 1 > R = BSplineBasis::Derive<Degree - 1>(span - 1, Q, m_knots.data() + 1);
+        return BSplineBasis::DeBoor<Degree - 2>(t, span - 2, R, m_knots.data() + 2);
+    }
+
+    std::vector< point > m_ctrl_pts;
+    std::vector< Knot >  m_knots;
+};
+
+using QuadraticBSpline2d = BSpline<2, 2, float>;
+using CubicBSpline3d = BSpline<3, 3, float>;
+
+extern template class BSpline<2, 2, float>;
+extern template class BSpline<3, 2, float>;
+extern template class BSpline<3, 3, float>;
+extern template class BSpline<3, 2, float, double>;
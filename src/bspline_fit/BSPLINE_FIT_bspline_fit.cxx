@@ -0,0 +1,332 @@
+#include "../bspline_fit/bspline_fit.h"
+#include "../bspline/bspline.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+namespace
+{
+    // Lower half of a symmetric matrix with 3 diagonals on either side of its own : A[i][d] is A(i, i - d).
+    using symmetric_band = std::vector<std::array<double, 4>>;
+
+    // Row i of a matrix with 2 diagonals on either side of its own : A[i][c - i + 2] is A(i, c).
+    using collocation_band = std::vector<std::array<double, 5>>;
+
+    // Non-zero basis functions N[j] of the control points span - 3 + j at t, by the Cox-de Boor triangle.
+    void BasisFunctions(double t, size_t span, const std::vector<double>& knots, double (&N)[4])
+    {
+        double left[4];
+        double right[4];
+        N[0] = 1.0;
+        for (size_t j = 1; j <= 3; ++j)
+        {
+            left[j] = t - knots[span + 1 - j];
+            right[j] = knots[span + j] - t;
+            double saved = 0.0;
+            for (size_t r = 0; r < j; ++r)
+            {
+                const double temp = N[r] / (right[r + 1] + left[j - r]);
+                N[r] = saved + right[r + 1] * temp;
+                saved = left[j - r] * temp;
+            }
+            N[j] = saved;
+        }
+    }
+
+    // Adds weight * (c . P - target)^2 to the normal equations over the control points from first. The
+    // first and last control points are known, they move to the right hand side ; unknown i is point i + 1.
+    void AddObservation
+    (
+        symmetric_band& A,
+        std::vector<glm::dvec2>& b,
+        std::span<const glm::vec2> ctrl_pts,
+        size_t first,
+        std::span<const double> c,
+        glm::dvec2 target,
+        double weight
+    )
+    {
+        const size_t last = ctrl_pts.size() - 1;
+        auto is_known = [&](size_t i) { return i == 0 || i == last; };
+
+        for (size_t j = 0; j < c.size(); ++j)
+        {
+            if (is_known(first + j))
+            {
+                target -= c[j] * glm::dvec2(ctrl_pts[first + j]);
+            }
+        }
+
+        for (size_t j = 0; j < c.size(); ++j)
+        {
+            if (is_known(first + j))
+            {
+                continue;
+            }
+            b[first + j - 1] += weight * c[j] * target;
+            for (size_t k = 0; k <= j; ++k)
+            {
+                if (!is_known(first + k))
+                {
+                    A[first + j - 1][j - k] += weight * c[j] * c[k];
+                }
+            }
+        }
+    }
+
+    // Cholesky factorization of A in place, then forward and back substitution of b. False when A is
+    // not positive definite, down to rounding.
+    bool SolveSymmetricBand(symmetric_band& A, std::vector<glm::dvec2>& b)
+    {
+        constexpr double min_pivot = 1e-12;
+
+        const size_t n = A.size();
+        for (size_t i = 0; i < n; ++i)
+        {
+            const size_t first = i >= 3 ? i - 3 : 0;
+            for (size_t j = first; j < i; ++j)
+            {
+                double sum = A[i][i - j];
+                for (size_t k = first; k < j; ++k)
+                {
+                    sum -= A[i][i - k] * A[j][j - k];
+                }
+                A[i][i - j] = sum / A[j][0];
+            }
+
+            double diagonal = A[i][0];
+            for (size_t k = first; k < i; ++k)
+            {
+                diagonal -= A[i][i - k] * A[i][i - k];
+            }
+            if (!(diagonal > min_pivot * A[i][0]))
+            {
+                return false;
+            }
+            A[i][0] = std::sqrt(diagonal);
+        }
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            for (size_t k = i >= 3 ? i - 3 : 0; k < i; ++k)
+            {
+                b[i] -= A[i][i - k] * b[k];
+            }
+            b[i] /= A[i][0];
+        }
+        for (size_t i = n; i-- > 0;)
+        {
+            for (size_t k = i + 1; k < std::min(i + 4, n); ++k)
+            {
+                b[i] -= A[k][k - i] * b[k];
+            }
+            b[i] /= A[i][0];
+        }
+        return true;
+    }
+
+    // Gaussian elimination without pivoting, which collocation matrices of B-splines do not need, then
+    // back substitution of b. Rows stay within the band. False on a zero pivot.
+    bool SolveCollocationBand(collocation_band& A, std::vector<glm::dvec2>& b)
+    {
+        constexpr double min_pivot = 1e-12;
+
+        const size_t n = A.size();
+        for (size_t i = 0; i < n; ++i)
+        {
+            const double pivot = A[i][2];
+            if (std::abs(pivot) < min_pivot)
+            {
+                return false;
+            }
+
+            for (size_t r = i + 1; r < std::min(i + 3, n); ++r)
+            {
+                const double factor = A[r][i + 2 - r] / pivot;
+                if (factor == 0.0)
+                {
+                    continue;
+                }
+                for (size_t c = i; c < std::min(i + 3, n); ++c)
+                {
+                    A[r][c + 2 - r] -= factor * A[i][c + 2 - i];
+                }
+                b[r] -= factor * b[i];
+            }
+        }
+
+        for (size_t i = n; i-- > 0;)
+        {
+            for (size_t c = i + 1; c < std::min(i + 3, n); ++c)
+            {
+                b[i] -= A[i][c + 2 - i] * b[c];
+            }
+            b[i] /= A[i][2];
+        }
+        return true;
+    }
+}
+
+std::vector<double> BSplineFit::ComputeParameters
+(
+    std::span<const glm::vec2> points,
+    Parameterization parameterization
+)
+{
+    std::vector<double> t(points.size(), 0.0);
+    for (size_t i = 1; i < points.size(); ++i)
+    {
+        const double distance = glm::distance(glm::dvec2(points[i]), glm::dvec2(points[i - 1]));
+        double step = 1.0;
+        switch (parameterization)
+        {
+            using enum Parameterization;
+        case UNIFORM:      { step = 1.0;                  } break;
+        case CHORD_LENGTH: { step = distance;             } break;
+        case CENTRIPETAL:  { step = std::sqrt(distance);  } break;
+        }
+        t[i] = t[i - 1] + step;
+    }
+
+    if (points.size() > 1 && t.back() > 0.0)
+    {
+        const double length = t.back();
+        for (double& ti : t)
+        {
+            ti /= length;
+        }
+        t.back() = 1.0;
+    }
+    return t;
+}
+
+std::optional<CubicBSpline2d> BSplineFit::Interpolate
+(
+    std::span<const glm::vec2> points,
+    Parameterization parameterization
+)
+{
+    // Repeated points would have the same parameter, and the same row.
+    std::vector<glm::vec2> distinct_points;
+    distinct_points.reserve(points.size());
+    for (const glm::vec2& point : points)
+    {
+        if (distinct_points.empty() || point != distinct_points.back())
+        {
+            distinct_points.push_back(point);
+        }
+    }
+
+    const size_t n = distinct_points.size();
+    if (n < 4)
+    {
+        return std::nullopt;
+    }
+
+    // Each interior knot averages 3 consecutive parameters, the parameter k then lies strictly inside
+    // the knots k + 1 and k + 3 and its row is zero outside of the columns k - 2 to k + 2.
+    const std::vector<double> t = ComputeParameters(distinct_points, parameterization);
+    std::vector<double> knots(n + 4, 0.0);
+    for (size_t j = 1; j + 3 < n; ++j)
+    {
+        knots[j + 3] = (t[j] + t[j + 1] + t[j + 2]) / 3.0;
+    }
+    std::fill(knots.end() - 4, knots.end(), 1.0);
+
+    collocation_band A(n, { 0.0, 0.0, 0.0, 0.0, 0.0 });
+    std::vector<glm::dvec2> b(n);
+    for (size_t k = 0; k < n; ++k)
+    {
+        b[k] = distinct_points[k];
+    }
+    A.front()[2] = 1.0;
+    A.back()[2] = 1.0;
+
+    size_t span = 3;
+    for (size_t k = 1; k + 1 < n; ++k)
+    {
+        while (span + 1 < n && t[k] >= knots[span + 1])
+        {
+            ++span;
+        }
+
+        // Parameters too close to be told apart from the knots in double precision.
+        if (span > k + 2 || span + 1 < k + 2)
+        {
+            return std::nullopt;
+        }
+
+        double N[4];
+        BasisFunctions(t[k], span, knots, N);
+        for (size_t j = 0; j < 4; ++j)
+        {
+            A[k][span - 3 + j + 2 - k] = N[j];
+        }
+    }
+
+    if (!SolveCollocationBand(A, b))
+    {
+        return std::nullopt;
+    }
+
+    std::vector<glm::vec2> ctrl_pts(b.begin(), b.end());
+    return CubicBSpline2d(ctrl_pts, std::move(knots));
+}
+
+std::optional<std::vector<glm::vec2>> BSplineFit::Approximate
+(
+    std::span<const glm::vec2> points,
+    size_t nb_ctrl_pts,
+    Parameterization parameterization,
+    double smoothing
+)
+{
+    assert(nb_ctrl_pts > 3);
+
+    if (points.size() < 2)
+    {
+        return std::nullopt;
+    }
+
+    const std::vector<double> t = ComputeParameters(points, parameterization);
+    const std::vector<double> knots = BSplineBasis::ClampedUniformKnots<double>(3, nb_ctrl_pts);
+    const size_t nb_spans = nb_ctrl_pts - 3;
+
+    std::vector<glm::vec2> ctrl_pts(nb_ctrl_pts);
+    ctrl_pts.front() = points.front();
+    ctrl_pts.back() = points.back();
+
+    symmetric_band A(nb_ctrl_pts - 2, { 0.0, 0.0, 0.0, 0.0 });
+    std::vector<glm::dvec2> b(nb_ctrl_pts - 2, glm::dvec2(0.0));
+    for (size_t k = 0; k < points.size(); ++k)
+    {
+        // The knots are uniform, the span is found without searching.
+        const size_t span = 3 + std::min(static_cast<size_t>(t[k] * static_cast<double>(nb_spans)), nb_spans - 1);
+
+        double N[4];
+        BasisFunctions(t[k], span, knots, N);
+        AddObservation(A, b, ctrl_pts, span - 3, N, points[k], 1.0);
+    }
+
+    // Scaled by the number of points per control point, so that it does not depend on the sampling.
+    if (smoothing > 0.0)
+    {
+        constexpr double second_difference[3] = { 1.0, -2.0, 1.0 };
+        const double weight = smoothing * static_cast<double>(points.size()) / static_cast<double>(nb_ctrl_pts);
+        for (size_t i = 0; i + 2 < nb_ctrl_pts; ++i)
+        {
+            AddObservation(A, b, ctrl_pts, i, second_difference, glm::dvec2(0.0), weight);
+        }
+    }
+
+    if (!SolveSymmetricBand(A, b))
+    {
+        return std::nullopt;
+    }
+
+    std::copy(b.begin(), b.end(), ctrl_pts.begin() + 1);
+    return ctrl_pts;
+}
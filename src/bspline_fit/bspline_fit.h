@@ -0,0 +1,35 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "../cubic_bspline_2d/cubic_bspline_2d.h"
+
+// Cubic B-splines through or near a sequence of points, as sampled along a trace. Each point only
+// weighs on the 4 control points of its knot span, so the systems are banded and solved in time
+// linear in the number of points.
+namespace BSplineFit
+{
+    enum class Parameterization
+    {
+        UNIFORM,
+        CHORD_LENGTH,       // Steps proportional to the distance between the points.
+        CENTRIPETAL         // Steps proportional to its square root, which overshoots less at sharp turns.
+    };
+
+    // Parameter in [0, 1] of every point, from 0 on the first one to 1 on the last.
+    std::vector<double> ComputeParameters(std::span<const glm::vec2> points, Parameterization parameterization);
+
+    // Spline through every point at its parameter. Its knots are averages of the parameters, which
+    // keeps the system banded and solvable, so it is added to the scene as its Bezier form.
+    // Repeated points are merged, there is no spline through fewer than 4 distinct points.
+    std::optional<CubicBSpline2d> Interpolate(std::span<const glm::vec2> points, Parameterization parameterization);
+
+    // Control points on the knots of CubicBSpline2d closest to the points in the least squares sense,
+    // through the first and the last one, to add to the scene as they are. smoothing weighs the second
+    // differences of the control points against the distances ; a little of it keeps the fit defined
+    // when some knot spans hold no point, as across gaps in the trace. Without, there is none then.
+    std::optional<std::vector<glm::vec2>> Approximate(std::span<const glm::vec2> points, size_t nb_ctrl_pts, Parameterization parameterization, double smoothing = 0.0);
+};
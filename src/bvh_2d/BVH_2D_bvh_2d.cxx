@@ -0,0 +1,134 @@
+#include "../bvh_2d/bvh_2d.h"
+
+#include <algorithm>
+
+void Bvh2d::Build(std::span<const BoundingBox2d> boxes)
+{
+    m_boxes.assign(boxes.begin(), boxes.end());
+    m_nodes.clear();
+    m_items.resize(boxes.size());
+    m_item_leaves.resize(boxes.size());
+    if (boxes.empty())
+    {
+        return;
+    }
+
+    std::vector<glm::vec2> centers(boxes.size());
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+        m_items[i] = static_cast<uint32_t>(i);
+        centers[i] = boxes[i].GetCenter();
+    }
+
+    m_nodes.reserve(2 * (boxes.size() / leaf_size + 1));
+    m_nodes.emplace_back();
+    BuildNode(0, 0, static_cast<uint32_t>(boxes.size()), centers, 0);
+}
+
+void Bvh2d::BuildNode
+(
+    uint32_t index,
+    uint32_t begin,
+    uint32_t end,
+    std::span<const glm::vec2> centers,
+    size_t depth
+)
+{
+    BoundingBox2d box;
+    BoundingBox2d center_box;
+    for (uint32_t i = begin; i < end; ++i)
+    {
+        box.Extend(m_boxes[m_items[i]]);
+        center_box.Extend(centers[m_items[i]]);
+    }
+    m_nodes[index].box = box;
+
+    // The depth stays under max_depth for any item count a uint32_t can index.
+    if (end - begin <= leaf_size || depth + 1 >= max_depth)
+    {
+        m_nodes[index].first = begin;
+        m_nodes[index].count = end - begin;
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            m_item_leaves[m_items[i]] = index;
+        }
+        return;
+    }
+
+    const glm::vec2 size = center_box.GetSize();
+    const size_t axis = size.x < size.y ? 1 : 0;
+    const uint32_t middle = begin + (end - begin) / 2;
+    std::nth_element(m_items.begin() + begin, m_items.begin() + middle, m_items.begin() + end, [&](uint32_t a, uint32_t b)
+        {
+            return centers[a][axis] < centers[b][axis];
+        });
+
+    const auto left = static_cast<uint32_t>(m_nodes.size());
+    m_nodes[index].first = left;
+    m_nodes[index].count = 0;
+    m_nodes.emplace_back();
+    m_nodes.emplace_back();
+    m_nodes[left].parent = index;
+    m_nodes[left + 1].parent = index;
+
+    BuildNode(left, begin, middle, centers, depth + 1);
+    BuildNode(left + 1, middle, end, centers, depth + 1);
+}
+
+void Bvh2d::Update
+(
+    size_t item,
+    const BoundingBox2d& box
+)
+{
+    m_boxes[item] = box;
+
+    uint32_t index = m_item_leaves[item];
+    {
+        node& leaf = m_nodes[index];
+        BoundingBox2d leaf_box;
+        for (uint32_t i = leaf.first; i < leaf.first + leaf.count; ++i)
+        {
+            leaf_box.Extend(m_boxes[m_items[i]]);
+        }
+        if (leaf_box == leaf.box)
+        {
+            return;
+        }
+        leaf.box = leaf_box;
+    }
+
+    // Up to the first ancestor whose box does not change.
+    while (m_nodes[index].parent != UINT32_MAX)
+    {
+        index = m_nodes[index].parent;
+        node& n = m_nodes[index];
+        BoundingBox2d node_box = m_nodes[n.first].box;
+        node_box.Extend(m_nodes[n.first + 1].box);
+        if (node_box == n.box)
+        {
+            return;
+        }
+        n.box = node_box;
+    }
+}
+
+bool Bvh2d::IsEmpty() const
+{
+    return m_nodes.empty();
+}
+
+size_t Bvh2d::GetNbItems() const
+{
+    return m_boxes.size();
+}
+
+BoundingBox2d Bvh2d::GetBounds() const
+{
+    return m_nodes.empty() ? BoundingBox2d() : m_nodes[0].box;
+}
+
+const BoundingBox2d& Bvh2d::GetItemBounds(size_t item) const
+{
+    return m_boxes[item];
+}
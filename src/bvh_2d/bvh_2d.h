@@ -0,0 +1,146 @@
+#pragma once
+
+#include "../bounding_box_2d/bounding_box_2d.h"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+// Binary bounding volume hierarchy over items known by their index and box. Built top down by
+// median split on the longest axis, boxes can then be updated one item at a time by refitting.
+class Bvh2d
+{
+public:
+    static constexpr uint32_t leaf_size = 4;
+
+    void Build(std::span<const BoundingBox2d> boxes);
+
+    // Refits the leaf of item and its ancestors. The tree is not rebalanced, Build again
+    // after large moves.
+    void Update(size_t item, const BoundingBox2d& box);
+
+    bool IsEmpty() const;
+    size_t GetNbItems() const;
+    BoundingBox2d GetBounds() const;
+    const BoundingBox2d& GetItemBounds(size_t item) const;
+
+    // Calls visit(item) for every item whose box overlaps box.
+    template <class Visit>
+    void Query(const BoundingBox2d& box, Visit&& visit) const;
+
+    // Nearest first walk : visit(item, best_distance2) returns the squared distance from point to
+    // the item, or best_distance2 when it is not closer. Items whose box is not closer than the best
+    // distance so far are skipped. Returns the best squared distance, max_distance2 if none is closer.
+    template <class Visit>
+    float FindNearest(const glm::vec2& point, float max_distance2, Visit&& visit) const;
+
+private:
+    // Leaves have count items from m_items[first], inner nodes have their children at first and first + 1.
+    struct node
+    {
+        BoundingBox2d box;
+        uint32_t first = 0;
+        uint32_t count = 0;
+        uint32_t parent = UINT32_MAX;
+    };
+
+    static constexpr size_t max_depth = 64;
+
+    void BuildNode(uint32_t index, uint32_t begin, uint32_t end, std::span<const glm::vec2> centers, size_t depth);
+
+    std::vector<node> m_nodes;
+    std::vector<uint32_t> m_items;
+    std::vector<uint32_t> m_item_leaves;
+    std::vector<BoundingBox2d> m_boxes;
+};
+
+template <class Visit>
+void Bvh2d::Query(const BoundingBox2d& box, Visit&& visit) const
+{
+    if (m_nodes.empty())
+    {
+        return;
+    }
+
+    std::array<uint32_t, max_depth + 1> stack;
+    size_t size = 0;
+    stack[size++] = 0;
+    while (size > 0)
+    {
+        const node& n = m_nodes[stack[--size]];
+        if (!n.box.Overlaps(box))
+        {
+            continue;
+        }
+
+        if (n.count > 0)
+        {
+            for (uint32_t i = n.first; i < n.first + n.count; ++i)
+            {
+                if (m_boxes[m_items[i]].Overlaps(box))
+                {
+                    visit(static_cast<size_t>(m_items[i]));
+                }
+            }
+        }
+        else
+        {
+            stack[size++] = n.first;
+            stack[size++] = n.first + 1;
+        }
+    }
+}
+
+template <class Visit>
+float Bvh2d::FindNearest(const glm::vec2& point, float max_distance2, Visit&& visit) const
+{
+    float best = max_distance2;
+    if (m_nodes.empty())
+    {
+        return best;
+    }
+
+    std::array<std::pair<uint32_t, float>, max_depth + 1> stack;
+    size_t size = 0;
+    stack[size++] = { 0, m_nodes[0].box.DistanceSquared(point) };
+    while (size > 0)
+    {
+        const auto [index, distance2] = stack[--size];
+        if (distance2 >= best)
+        {
+            continue;
+        }
+
+        const node& n = m_nodes[index];
+        if (n.count > 0)
+        {
+            for (uint32_t i = n.first; i < n.first + n.count; ++i)
+            {
+                if (m_boxes[m_items[i]].DistanceSquared(point) < best)
+                {
+                    best = visit(static_cast<size_t>(m_items[i]), best);
+                }
+            }
+            continue;
+        }
+
+        // The closer child is pushed last to be visited first.
+        float near_distance2 = m_nodes[n.first].box.DistanceSquared(point);
+        float far_distance2 = m_nodes[n.first + 1].box.DistanceSquared(point);
+        uint32_t near_child = n.first;
+        uint32_t far_child = n.first + 1;
+        if (far_distance2 < near_distance2)
+        {
+            std::swap(near_distance2, far_distance2);
+            std::swap(near_child, far_child);
+        }
+        assert(size + 2 <= stack.size());
+        stack[size++] = { far_child, far_distance2 };
+        stack[size++] = { near_child, near_distance2 };
+    }
+
+    return best;
+}
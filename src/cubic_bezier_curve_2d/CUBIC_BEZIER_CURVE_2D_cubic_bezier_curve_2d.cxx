@@ -1,7 +1,11 @@
 #include "cubic_bezier_curve_2d.h"
+#include "../cubic_polynomial_2d/cubic_polynomial_2d.h"
+
+#include <cmath>
+#include <limits>
 
 CubicBezierCurve2d::CubicBezierCurve2d(const std::array<glm::vec2, 4>& ctrl_pts)
-	: P(ctrl_pts)
+	: Bezier(ctrl_pts)
 {
 }
 
@@ -12,24 +16,66 @@ CubicBezierCurve2d::CubicBezierCurve2d
 	const glm::vec2& P2,
 	const glm::vec2& P3
 )
-	: P{ P0, P1, P2, P3 }
+	: Bezier({ P0, P1, P2, P3 })
+{
+}
+
+CubicBezierCurve2d CubicBezierCurve2d::FromCubicHermiteCurve2d(const CubicHermiteCurve2d& cubic_hermite_curve_2d)
 {
+	return CubicBezierCurve2d(cubic_hermite_curve_2d.P);
 }
 
-glm::vec2 CubicBezierCurve2d::Eval(float u) const
+void CubicBezierCurve2d::Eval(std::span<const float> u, std::span<glm::vec2> pts) const
 {
-	return
-		P[0] * (-u * u * u     + 3.f * u * u - 3.f * u + 1.f) +
-		P[1] * ( 3.f * u * u * u - 6.f * u * u + 3.f * u) +
-		P[2] * (-3.f * u * u * u + 3.f * u * u) +
-		P[3] *   u * u * u;
+	CubicPolynomial2d::FromBezier(P[0], P[1], P[2], P[3]).Eval(u, pts);
 }
 
-glm::vec2 CubicBezierCurve2d::EvalFirstDerivative(float u) const
+BoundingBox2d CubicBezierCurve2d::GetBounds() const
 {
-	glm::vec2 T1 = (P[1] - P[0]);
-	glm::vec2 T2 = (P[2] - P[1]);
-	glm::vec2 T3 = (P[3] - P[2]);
+	BoundingBox2d box;
+	box.Extend(P[0]);
+	box.Extend(P[3]);
+
+	// B'(u) / 3 = a u^2 + b u + c on each coordinate.
+	const glm::vec2 a = -P[0] + 3.f * P[1] - 3.f * P[2] + P[3];
+	const glm::vec2 b = 2.f * (P[0] - 2.f * P[1] + P[2]);
+	const glm::vec2 c = P[1] - P[0];
+
+	auto extend_at = [&](float u)
+		{
+			if (0.f < u && u < 1.f)
+			{
+				box.Extend(Eval(u));
+			}
+		};
 
-	return 3.f * ((1.f - u) * (1.f -u) * T1 + 2.f * u * (1.f - u) * T2 + u * u * T3);
-}
\ No newline at end of file
+	const float epsilon = 1e-6f * glm::max(glm::length(b), glm::length(c)) + std::numeric_limits<float>::min();
+	for (glm::length_t axis = 0; axis < 2; ++axis)
+	{
+		if (std::abs(a[axis]) < epsilon)
+		{
+			if (std::abs(b[axis]) >= epsilon)
+			{
+				extend_at(-c[axis] / b[axis]);
+			}
+			continue;
+		}
+
+		const float discriminant = b[axis] * b[axis] - 4.f * a[axis] * c[axis];
+		if (discriminant < 0.f)
+		{
+			continue;
+		}
+		const float root = std::sqrt(discriminant);
+		extend_at((-b[axis] + root) / (2.f * a[axis]));
+		extend_at((-b[axis] - root) / (2.f * a[axis]));
+	}
+
+	return box;
+}
+
+std::pair< CubicBezierCurve2d, CubicBezierCurve2d > CubicBezierCurve2d::Subdivide(float u) const
+{
+	const auto [left, right] = Bezier::Subdivide(u);
+	return { CubicBezierCurve2d(left.P), CubicBezierCurve2d(right.P) };
+}
@@ -2,15 +2,28 @@
 
 #include "glm/vec2.hpp"
 #include <array>
+#include <span>
+#include <utility>
 
-class CubicBezierCurve2d
+#include "../cubic_hermite_curve_2d/cubic_hermite_curve_2d.h"
+#include "../bounding_box_2d/bounding_box_2d.h"
+#include "../bezier/bezier.h"
+
+// The cubic 2D case of Bezier, with the conversions, bounds and batched evaluation the splines build on.
+class CubicBezierCurve2d : public Bezier<3, 2, float>
 {
 public:
     explicit CubicBezierCurve2d(const std::array< glm::vec2, 4 >& ctrl_pts);
     CubicBezierCurve2d(const glm::vec2& P0, const glm::vec2& P1, const glm::vec2& P2, const glm::vec2& P3);
 
-    glm::vec2 Eval(float u) const;
-    glm::vec2 EvalFirstDerivative(float t) const;
+    static CubicBezierCurve2d FromCubicHermiteCurve2d(const CubicHermiteCurve2d& cubic_hermite_curve_2d);
+
+    using Bezier::Eval;
+    void Eval(std::span<const float> u, std::span<glm::vec2> pts) const;
+
+    // Exact bounds : the end points and the extrema of each coordinate, where the derivative vanishes.
+    BoundingBox2d GetBounds() const;
 
-    std::array< glm::vec2, 4 > P;
+    // de Casteljau split at u into the curves over [0, u] and [u, 1].
+    std::pair< CubicBezierCurve2d, CubicBezierCurve2d > Subdivide(float u) const;
 };
\ No newline at end of file
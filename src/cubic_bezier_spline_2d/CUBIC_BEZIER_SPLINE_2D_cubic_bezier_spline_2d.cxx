@@ -1,13 +1,15 @@
 #include "../cubic_bezier_spline_2d/cubic_bezier_spline_2d.h"
 #include "../cubic_hermite_spline_2d/cubic_hermite_spline_2d.h"
+#include "../cubic_bspline_2d/cubic_bspline_2d.h"
+#include "../cubic_polynomial_2d/cubic_polynomial_2d.h"
 
-#include <limits>
+#include <algorithm>
+#include <array>
 
-const double epsilon = std::numeric_limits<double>::epsilon();
-
-CubicBezierSpline2d::CubicBezierSpline2d(const std::vector< glm::vec2 >& ctrl_pts)
+CubicBezierSpline2d::CubicBezierSpline2d(std::span<const glm::vec2> ctrl_pts)
 {
-    for (size_t i = 0; i < ctrl_pts.size() - 3; i += 4)
+    m_curves.reserve(ctrl_pts.size() / 4);
+    for (size_t i = 0; i + 3 < ctrl_pts.size(); i += 4)
     {
         m_curves.emplace_back(ctrl_pts[i], ctrl_pts[i + 1], ctrl_pts[i + 2], ctrl_pts[i + 3]);
     }
@@ -15,43 +17,86 @@ CubicBezierSpline2d::CubicBezierSpline2d(const std::vector< glm::vec2 >& ctrl_pt
 
 CubicBezierSpline2d CubicBezierSpline2d::FromCubicHermiteSpline2d(const CubicHermiteSpline2d& cubic_hermite_spline_2d)
 {
-    size_t nb_ctrl_pts = cubic_hermite_spline_2d.m_curves.size() * 4;
-    std::vector<glm::vec2> ctrl_pts(nb_ctrl_pts);
-
-    for (size_t i = 0; i < cubic_hermite_spline_2d.m_curves.size(); i++)
+    // The points of a Hermite curve are its Bezier points.
+    std::vector<glm::vec2> ctrl_pts;
+    ctrl_pts.reserve(cubic_hermite_spline_2d.m_curves.size() * 4);
+    for (const CubicHermiteCurve2d& curve : cubic_hermite_spline_2d.m_curves)
     {
-        ctrl_pts[i * 4]     = cubic_hermite_spline_2d.m_curves[i].P0;
-        ctrl_pts[i * 4 + 1] = cubic_hermite_spline_2d.m_curves[i].P0 + cubic_hermite_spline_2d.m_curves[i].N0;
-        ctrl_pts[i * 4 + 2] = cubic_hermite_spline_2d.m_curves[i].P1 + cubic_hermite_spline_2d.m_curves[i].N1;
-        ctrl_pts[i * 4 + 3] = cubic_hermite_spline_2d.m_curves[i].P1;
+        ctrl_pts.insert(ctrl_pts.end(), curve.P.begin(), curve.P.end());
     }
 
     return CubicBezierSpline2d(ctrl_pts);
 }
 
-CubicBezierSpline2d CubicBezierSpline2d::FromCubicBSplinePoints2d(const std::vector<glm::vec2>& ctrl_pts)
+// Boehm knot insertion bringing every interior knot to multiplicity 3, left to right in a single
+// pass (The NURBS Book, A5.6) : once a knot is full, the 4 points before it are the Bezier points
+// of its span, and the points the insertion leaves behind start the next span.
+CubicBezierSpline2d CubicBezierSpline2d::FromCubicBSpline2d(const CubicBSpline2d& cubic_bspline_2d)
 {
-    std::vector<glm::vec2> resized_ctrl_pts = ctrl_pts;
-    for (size_t i = 0; i < ctrl_pts.size() % 3; i++)
+    constexpr size_t p = 3;
+    const std::vector<glm::vec2>& P = cubic_bspline_2d.m_ctrl_pts;
+    const std::vector<double>& U = cubic_bspline_2d.m_knots;
+    const size_t m = U.size() - 1;
+
+    std::vector<glm::vec2> ctrl_pts;
+    ctrl_pts.reserve((P.size() - p) * 4);
+
+    std::array<glm::vec2, 4> Q = { P[0], P[1], P[2], P[3] };
+    std::array<glm::vec2, 4> next_Q = {};
+    size_t a = p;
+    size_t b = p + 1;
+    while (b < m)
     {
-        resized_ctrl_pts.pop_back();
-    }
+        const size_t first = b;
+        while (b < m && U[b + 1] == U[b])
+        {
+            ++b;
+        }
+        // A knot repeated p + 1 times or more breaks the curve, the next span then starts from its
+        // own p + 1 points just as after a knot of multiplicity p.
+        const size_t multiplicity = std::min(b - first + 1, p);
 
-    std::vector<glm::vec2> bezier_ctrl_pts;
-    for (size_t i = 0; i < resized_ctrl_pts.size() - 2; i+= 3)
-    {
-        const glm::vec2& P0 = resized_ctrl_pts[i];
-        const glm::vec2& P1 = resized_ctrl_pts[i + 1];
-        const glm::vec2& P2 = resized_ctrl_pts[i + 2];
-        const glm::vec2& P3 = resized_ctrl_pts[i + 3];
-
-        bezier_ctrl_pts.push_back(P0);
-        bezier_ctrl_pts.push_back(P1);
-        bezier_ctrl_pts.push_back(P2);
-        bezier_ctrl_pts.push_back(P3);
+        if (multiplicity < p)
+        {
+            double alphas[p];
+            for (size_t j = p; j > multiplicity; --j)
+            {
+                alphas[j - multiplicity - 1] = (U[b] - U[a]) / (U[a + j] - U[a]);
+            }
+
+            const size_t nb_insertions = p - multiplicity;
+            for (size_t j = 1; j <= nb_insertions; ++j)
+            {
+                const size_t s = multiplicity + j;
+                for (size_t k = p; k >= s; --k)
+                {
+                    const auto alpha = static_cast<float>(alphas[k - s]);
+                    Q[k] = alpha * Q[k] + (1.f - alpha) * Q[k - 1];
+                }
+                next_Q[nb_insertions - j] = Q[p];
+            }
+        }
+
+        ctrl_pts.insert(ctrl_pts.end(), Q.begin(), Q.end());
+
+        if (b < m)
+        {
+            for (size_t i = p - multiplicity; i <= p; ++i)
+            {
+                next_Q[i] = P[b - p + i];
+            }
+            Q = next_Q;
+            a = b;
+            ++b;
+        }
     }
-    
-    return CubicBezierSpline2d(bezier_ctrl_pts);
+
+    return CubicBezierSpline2d(ctrl_pts);
+}
+
+CubicBezierSpline2d CubicBezierSpline2d::FromCubicBSplinePoints2d(std::span<const glm::vec2> ctrl_pts)
+{
+    return FromCubicBSpline2d(CubicBSpline2d(ctrl_pts));
 }
 
 void CubicBezierSpline2d::AddCurve(const CubicBezierCurve2d& cubic_bezier_curve_2d)
@@ -85,33 +130,24 @@ bool CubicBezierSpline2d::IsC1Continuous() const
 
 glm::vec2 CubicBezierSpline2d::Eval(double t) const
 {
-    if (t <= 0.0)
-    {
-        return m_curves.front().P[0];
-    }
-    else if (t >= 1.0 - epsilon)
-    {
-        return m_curves.back().P[3];
-    }
-
-    t = std::max(t, 0.0);
-    t = std::min(t, 1.0);
-    t *= static_cast<double>(m_curves.size());
-    double t_decimal = t - static_cast<int>(t);
-    int t_integer = t - t_decimal;
+    const auto [curve, u] = CubicPolynomial2d::FindPiece(m_curves.size(), t);
+    return m_curves[curve].Eval(u);
+}
 
-    return m_curves[t_integer].Eval(t_decimal);
+void CubicBezierSpline2d::Eval(std::span<const double> t, std::span<glm::vec2> pts) const
+{
+    auto get_curve = [this](size_t i)
+        {
+            const std::array<glm::vec2, 4>& P = m_curves[i].P;
+            return CubicPolynomial2d::FromBezier(P[0], P[1], P[2], P[3]);
+        };
+    CubicPolynomial2d::EvalPiecewise(m_curves.size(), get_curve, m_curves.front().P[0], m_curves.back().P[3], t, pts);
 }
 
 glm::vec2 CubicBezierSpline2d::EvalFirstDerivative(double t) const
 {
-    t = std::max(t, 0.);
-    t = std::min(t, 1. - epsilon);
-    t *= static_cast<double>(m_curves.size());
-    double t_decimal = t - static_cast<int>(t);
-    int t_integer = t - t_decimal;
-
-    return m_curves[t_integer].EvalFirstDerivative(t_decimal);
+    const auto [curve, u] = CubicPolynomial2d::FindPiece(m_curves.size(), t);
+    return m_curves[curve].EvalFirstDerivative(u);
 }
 
 std::vector<glm::vec2> CubicBezierSpline2d::GetControlPoints() const
@@ -126,3 +162,13 @@ std::vector<glm::vec2> CubicBezierSpline2d::GetControlPoints() const
     }
     return ctrl_pts;
 }
+
+BoundingBox2d CubicBezierSpline2d::GetBounds() const
+{
+    BoundingBox2d box;
+    for (const auto& curve : m_curves)
+    {
+        box.Extend(curve.GetBounds());
+    }
+    return box;
+}
@@ -1,20 +1,25 @@
 #pragma once
 
+#include <span>
 #include <vector>
 
 #include "../cubic_bezier_curve_2d/cubic_bezier_curve_2d.h"
 #include "../cubic_hermite_spline_2d/cubic_hermite_spline_2d.h"
 
 class CubicHermiteSpline2d;
+class CubicBSpline2d;
 
 class CubicBezierSpline2d
 {
 public:
-    explicit CubicBezierSpline2d(const std::vector< glm::vec2 >& ctrl_pts);
+    explicit CubicBezierSpline2d(std::span<const glm::vec2> ctrl_pts);
 
     static CubicBezierSpline2d FromCubicHermiteSpline2d(const CubicHermiteSpline2d& cubic_hermite_spline_2d);
-    //static CubicBezierSpline2d FromCubicBSpline2d(const CubicBSpline2d& cubic_bspline_2d);
-    static CubicBezierSpline2d FromCubicBSplinePoints2d(const std::vector <glm::vec2>& ctrl_pts);
+    // Same curve, one Bezier curve per non-empty knot span : curve k over [0, 1] traces span k over
+    // [u_s, u_s+1]. The parameters of Eval only match those of CubicBSpline2d::Eval on uniform knots,
+    // fitted splines and those built from their knots have spans of different widths.
+    static CubicBezierSpline2d FromCubicBSpline2d(const CubicBSpline2d& cubic_bspline_2d);
+    static CubicBezierSpline2d FromCubicBSplinePoints2d(std::span<const glm::vec2> ctrl_pts);
 
     void AddCurve(const CubicBezierCurve2d& cubic_bezier_curve_2d);
     void RemoveCurve(size_t index);
@@ -22,9 +27,11 @@ public:
     bool IsC1Continuous() const;
 
     glm::vec2 Eval(double t) const;
+    void Eval(std::span<const double> t, std::span<glm::vec2> pts) const;
     glm::vec2 EvalFirstDerivative(double t) const;
 
     std::vector<glm::vec2> GetControlPoints() const;
+    BoundingBox2d GetBounds() const;
 
     std::vector< CubicBezierCurve2d > m_curves;   
 };
\ No newline at end of file
@@ -1,166 +1,183 @@
 #include "../cubic_bezier_spline_2d/cubic_bezier_spline_2d.h"
 #include "../cubic_bspline_2d/cubic_bspline_2d.h"
 #include "../cubic_hermite_spline_2d/cubic_hermite_spline_2d.h"
+#include "../cubic_polynomial_2d/cubic_polynomial_2d.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <limits>
+#include <utility>
 
 namespace
 {
     const double epsilon = std::numeric_limits<double>::epsilon();
 
-    float N(double u, int i, int deg, const std::vector< double >& knots)
+    constexpr size_t lane_width = CubicPolynomial2d::lane_width;
+    constexpr size_t run_capacity = CubicPolynomial2d::run_capacity;
+
+    // Non-zero basis functions of the span at u by the Cox-de Boor triangle. U holds the knots
+    // span - 2 to span + 3 rescaled so that the span is [0, 1] and u is the local parameter.
+    void BasisFunctions(float u, const float (&U)[6], float (&N)[4])
     {
-        double ret = 0.0;
-        if (deg == 0)
+        float left[4];
+        float right[4];
+        N[0] = 1.f;
+        for (size_t j = 1; j <= 3; ++j)
         {
-            if (knots[i] <= u && u < knots[i + 1])
+            left[j] = u - U[3 - j];
+            right[j] = U[2 + j] - u;
+            float saved = 0.f;
+            for (size_t r = 0; r < j; ++r)
             {
-                ret = 1.0;
-            }
-            else
-            {
-                ret = 0.0;
+                float temp = N[r] / (right[r + 1] + left[j - r]);
+                N[r] = saved + right[r + 1] * temp;
+                saved = left[j - r] * temp;
             }
+            N[j] = saved;
         }
-        else
-        {
-
-            double N0 = 0.0;
-            double Q0 = (u - knots[i]);
-            double D0 = (knots[i + deg] - knots[i]);
+    }
 
-            if (D0 < epsilon)
-            {
-                Q0 = 0.0;
-                D0 = 1.0;
-            }
-            else
+    // Evaluates the local parameters u of a span, lane_width of them at a time.
+    void EvalSpan
+    (
+        const std::array< glm::vec2, 4 >& P,
+        const float (&U)[6],
+        std::span< const float > u,
+        std::span< glm::vec2 > pts
+    )
+    {
+        size_t i = 0;
+#ifdef SPLINE_USE_SSE2
+        float* out = reinterpret_cast<float*>(pts.data());
+        for (; i + lane_width <= u.size(); i += lane_width)
+        {
+            const __m128 v = _mm_loadu_ps(u.data() + i);
+            __m128 N[4];
+            __m128 left[4];
+            __m128 right[4];
+            N[0] = _mm_set1_ps(1.f);
+            for (size_t j = 1; j <= 3; ++j)
             {
-                N0 = N(u, i, deg - 1, knots);
+                left[j] = _mm_sub_ps(v, _mm_set1_ps(U[3 - j]));
+                right[j] = _mm_sub_ps(_mm_set1_ps(U[2 + j]), v);
+                __m128 saved = _mm_setzero_ps();
+                for (size_t r = 0; r < j; ++r)
+                {
+                    __m128 temp = _mm_div_ps(N[r], _mm_add_ps(right[r + 1], left[j - r]));
+                    N[r] = _mm_add_ps(saved, _mm_mul_ps(right[r + 1], temp));
+                    saved = _mm_mul_ps(left[j - r], temp);
+                }
+                N[j] = saved;
             }
 
-            double N1 = 0.0;//N( u, i+1, deg-1, knots );
-            double Q1 = (knots[i + deg + 1] - u);
-            double D1 = (knots[i + deg + 1] - knots[i + 1]);
-
-            if (D1 < epsilon)
-            {
-                Q1 = 0.0;
-                D1 = 1.0;
-            }
-            else
+            __m128 x = _mm_setzero_ps();
+            __m128 y = _mm_setzero_ps();
+            for (size_t j = 0; j < 4; ++j)
             {
-                N1 = N(u, i + 1, deg - 1, knots);
+                x = _mm_add_ps(x, _mm_mul_ps(N[j], _mm_set1_ps(P[j].x)));
+                y = _mm_add_ps(y, _mm_mul_ps(N[j], _mm_set1_ps(P[j].y)));
             }
-
-
-            ret = N0 * Q0 / D0 + N1 * Q1 / D1;
-
+            _mm_storeu_ps(out + 2 * i, _mm_unpacklo_ps(x, y));
+            _mm_storeu_ps(out + 2 * i + lane_width, _mm_unpackhi_ps(x, y));
+        }
+#endif
+        for (; i < u.size(); ++i)
+        {
+            float N[4];
+            BasisFunctions(u[i], U, N);
+            pts[i] = N[0] * P[0] + N[1] * P[1] + N[2] * P[2] + N[3] * P[3];
         }
-        return static_cast<float>(ret);
     }
 }
 
-CubicBSpline2d::CubicBSpline2d(const std::vector<glm::vec2>& ctrl_pts)
-    : m_ctrl_pts(ctrl_pts)
+CubicBSpline2d::CubicBSpline2d(std::span<const glm::vec2> ctrl_pts)
+    : BSpline(ctrl_pts)
+{
+}
+
+CubicBSpline2d::CubicBSpline2d
+(
+    std::span<const glm::vec2> ctrl_pts,
+    std::vector<double> knots
+)
+    : BSpline(ctrl_pts, std::move(knots))
 {
-    m_knots = ComputeKnots(ctrl_pts.size());
 }
 
 std::vector<double> CubicBSpline2d::ComputeKnots(size_t nb_ctrl_pts) const
 {
     assert(nb_ctrl_pts > 3);
-    
-    size_t knots_values_size = nb_ctrl_pts + 4;
-    std::vector<double> knots_values(knots_values_size);
-    
-    for (int i = 0; i < 3; i++)
-    {
-        knots_values[i] = 0.;
-		knots_values[knots_values_size - 1 - i] = 1.;
-    }
-
-    auto denominator = static_cast<double>(knots_values_size - 7);
-    for (int i = 4; i < knots_values.size() - 3; i++)
-    {
-        knots_values[i] = (i-3) / denominator;
-    }
+    return BSplineBasis::ClampedUniformKnots<double>(3, nb_ctrl_pts);
+}
 
-    return knots_values;
+CubicBezierCurve2d CubicBSpline2d::GetSpanBezierCurve(size_t span) const
+{
+    return CubicBezierCurve2d(GetSpanBezier(span).P);
 }
 
-glm::vec2 CubicBSpline2d::Eval
+void CubicBSpline2d::Eval
 (
-    double t
+    std::span<const double> t,
+    std::span<glm::vec2> pts
 ) const
 {
-    if (t <= 0.0)
-    {
-        return m_ctrl_pts.front();
-    }
-    else if (1.0 <= t + epsilon)
-    {
-        return m_ctrl_pts.back();
-    }
+    assert(t.size() == pts.size());
 
-    t = std::max(t, 0.0);
-    t = std::min(t, 1.0);
+    size_t span = 0;
+    std::array<glm::vec2, 4> P{};
+    double span_start = 0.0;
+    double span_width = 1.0;
+    float U[6] = {};
+    float u[run_capacity];
 
-    glm::vec2 eval_pt{};
-    size_t it_size = m_ctrl_pts.size();
-    for (size_t it = 0; it < it_size; ++it)
-    {
-        eval_pt += N(t, (int)it, 3, m_knots) * m_ctrl_pts[it];
-    }
-    return eval_pt;
-}
+    auto is_on_span = [&](double ti)
+        {
+            return 0.0 < ti && ti + epsilon < 1.0 && span != 0 && m_knots[span] <= ti && ti < m_knots[span + 1];
+        };
 
-glm::vec2 CubicBSpline2d::EvalFirstDerivative
-(
-    double t
-) const
-{
-    if (t <= 0.0)
-    {
-        t = 0.0;
-    }
-    else if (1.0 <= t + epsilon)
+    size_t i = 0;
+    while (i < t.size())
     {
-        t = 1.0;
-    }
+        // NaN as well, it is on no span and the walk would never move past it.
+        if (!(t[i] > 0.0))
+        {
+            pts[i++] = m_ctrl_pts.front();
+            continue;
+        }
+        if (1.0 <= t[i] + epsilon)
+        {
+            pts[i++] = m_ctrl_pts.back();
+            continue;
+        }
 
-    t = std::max(t, 0.0);
-    t = std::min(t, 1.0);
+        // Parameters are grouped by knot span, sorted inputs mostly move on to the next span.
+        if (!is_on_span(t[i]))
+        {
+            const bool is_on_next_span = span != 0 && span + 1 < m_ctrl_pts.size() && m_knots[span + 1] <= t[i] && t[i] < m_knots[span + 2];
+            span = is_on_next_span ? span + 1 : FindSpan(t[i]);
+            P = GetSpanControlPoints(span);
+            span_start = m_knots[span];
+            span_width = m_knots[span + 1] - span_start;
+            for (size_t j = 0; j < 6; ++j)
+            {
+                U[j] = static_cast<float>((m_knots[span - 2 + j] - span_start) / span_width);
+            }
+        }
 
-    glm::vec2 eval_pt{};
-    size_t it_size = m_ctrl_pts.size();
-    for (size_t it = 0; it < it_size - 2; ++it)
-    {
-        eval_pt += N(t, (int)it + 1, 2, m_knots) * (m_ctrl_pts[it + 1] - m_ctrl_pts[it]);
+        size_t count = 0;
+        while (count < run_capacity && i + count < t.size() && is_on_span(t[i + count]))
+        {
+            u[count] = static_cast<float>((t[i + count] - span_start) / span_width);
+            ++count;
+        }
+
+        EvalSpan(P, U, std::span<const float>(u, count), pts.subspan(i, count));
+        i += count;
     }
-    return eval_pt;
 }
 
-glm::vec2 CubicBSpline2d::EvalSecondDerivative
-(
-    double t
-) const
+BoundingBox2d CubicBSpline2d::GetBounds() const
 {
-    if (t <= 0.0)
-    {
-        t = 0.0;
-    }
-    else if (1.0 <= t + epsilon)
-    {
-        t = 1.0;
-    }
-
-    t = std::max(t, 0.0);
-    t = std::min(t, 1.0);
-
-    glm::vec2 eval_pt{};
-    size_t it_size = m_ctrl_pts.size();
-    for (size_t it = 0; it < it_size - 3; ++it)
-    {
-        eval_pt += N(t, (int)it + 2, 1, m_knots) * (m_ctrl_pts[it + 2] - m_ctrl_pts[it]);
-    }
-    return eval_pt;
-}
\ No newline at end of file
+    return CubicBezierSpline2d::FromCubicBSpline2d(*this).GetBounds();
+}
@@ -1,23 +1,30 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <span>
 #include <vector>
 
 #include "../cubic_bezier_spline_2d/cubic_bezier_spline_2d.h"
 #include "../cubic_hermite_spline_2d/cubic_hermite_spline_2d.h"
+#include "../bspline/bspline.h"
 
 // =============================================================================
-class CubicBSpline2d
+// The cubic 2D case of BSpline, double knots on float control points, with the bounds and the
+// batched evaluation by basis functions the scene builds on.
+class CubicBSpline2d : public BSpline<3, 2, float, double>
 {
 public:
-    explicit CubicBSpline2d(const std::vector< glm::vec2 >& ctrl_pts);
+    explicit CubicBSpline2d(std::span<const glm::vec2> ctrl_pts);
+    // Clamped knots on [0, 1], ctrl_pts.size() + 4 of them, as fitting makes.
+    CubicBSpline2d(std::span<const glm::vec2> ctrl_pts, std::vector<double> knots);
     
     std::vector<double> ComputeKnots(size_t nb_ctrl_pts) const;
 
-    glm::vec2 Eval(double t) const;
-    glm::vec2 EvalFirstDerivative(double t) const;
-    glm::vec2 EvalSecondDerivative(double t) const;
+    // Bezier form of the curve over the span, for spans in [3, m_ctrl_pts.size() - 1].
+    CubicBezierCurve2d GetSpanBezierCurve(size_t span) const;
 
-    std::vector< glm::vec2 > m_ctrl_pts;
-    std::vector< double >    m_knots;
+    using BSpline::Eval;
+    void Eval(std::span<const double> t, std::span<glm::vec2> pts) const;
+
+    BoundingBox2d GetBounds() const;
 };
\ No newline at end of file
@@ -1,40 +1,35 @@
 #include "cubic_hermite_curve_2d.h"
+#include "../cubic_polynomial_2d/cubic_polynomial_2d.h"
+#include "../cubic_bezier_curve_2d/cubic_bezier_curve_2d.h"
 
 CubicHermiteCurve2d::CubicHermiteCurve2d
 (
-	const glm::vec2& P0_,
-	const glm::vec2& P1_,
-	const glm::vec2& P2_,
-	const glm::vec2& P3_
+	const glm::vec2& P0,
+	const glm::vec2& P1,
+	const glm::vec2& P2,
+	const glm::vec2& P3
 )
-	: P0(P0_), P1(P3_), N0(P1_ - P0_), N1(P2_ - P3_)
+	: Bezier({ P0, P1, P2, P3 })
 {
 }
 
-glm::vec2 CubicHermiteCurve2d::Eval(float u) const
+CubicHermiteCurve2d CubicHermiteCurve2d::FromTangents
+(
+	const glm::vec2& P0,
+	const glm::vec2& P1,
+	const glm::vec2& N0,
+	const glm::vec2& N1
+)
 {
-	return 
-		P0 * ( 2.f * u * u * u - 3.f * u * u + 1.f) +
-		N0 * ( 3.f * u * u * u - 6.f * u * u + 3.f * u) +
-		P1 * (-2.f * u * u * u + 3.f * u * u) +
-		N1 * (-3.f * u * u * u + 3.f * u * u);
+	return CubicHermiteCurve2d(P0, P0 + N0, P1 + N1, P1);
 }
 
-glm::vec2 CubicHermiteCurve2d::EvalFirstDerivative(float u) const
+void CubicHermiteCurve2d::Eval(std::span<const float> u, std::span<glm::vec2> pts) const
 {
-	float h00_prime =  6.f * u * u - 6.f * u;
-	float h10_prime =  9.f * u * u - 12.f * u + 3.f;
-	float h01_prime = -6.f * u * u + 6.f * u;
-	float h11_prime = -9.f * u * u + 6.f * u;
-
-	return h00_prime * P0 + h10_prime * N0 + h01_prime * P1 + h11_prime * N1;
+	CubicPolynomial2d::FromBezier(P[0], P[1], P[2], P[3]).Eval(u, pts);
 }
-glm::vec2 CubicHermiteCurve2d::EvalSecondDerivative(float u) const
-{
-	float h00_prime_prime =  12.f * u - 6.f;
-	float h10_prime_prime =  18.f * u - 12.f;
-	float h01_prime_prime = -12.f * u + 6.f;
-	float h11_prime_prime = -18.f * u + 6.f;
 
-	return h00_prime_prime * P0 + h10_prime_prime * N0 + h01_prime_prime * P1 + h11_prime_prime * N1;
-}
\ No newline at end of file
+BoundingBox2d CubicHermiteCurve2d::GetBounds() const
+{
+	return CubicBezierCurve2d::FromCubicHermiteCurve2d(*this).GetBounds();
+}
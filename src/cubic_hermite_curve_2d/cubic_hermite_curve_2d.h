@@ -2,19 +2,25 @@
 
 #include <glm/glm.hpp>
 #include <array>
+#include <span>
 
-class CubicHermiteCurve2d
+#include "../bounding_box_2d/bounding_box_2d.h"
+#include "../bezier/bezier.h"
+
+// Cubic Hermite curve from P[0] to P[3], with the tangents N0 = P[1] - P[0] and N1 = P[2] - P[3] as
+// the editor places their handles. The Hermite basis on these tangents is the Bernstein basis on the
+// 4 points, so the curve is evaluated as the cubic 2D case of Bezier.
+class CubicHermiteCurve2d : public Bezier<3, 2, float>
 {
 public:
-    //CubicHermiteCurve2d(const glm::vec2& P0, const glm::vec2& P1, const glm::vec2& N0, const glm::vec2& N1);
     CubicHermiteCurve2d(const glm::vec2& P0, const glm::vec2& P1, const glm::vec2& P2, const glm::vec2& P3);
-    
-    glm::vec2 Eval(float u) const;
-    glm::vec2 EvalFirstDerivative(float t) const;
-    glm::vec2 EvalSecondDerivative(float t) const;
 
-    glm::vec2 P0;
-    glm::vec2 P1;
-    glm::vec2 N0;
-    glm::vec2 N1;
-};
\ No newline at end of file
+    // The curve from P0 to P1 with the tangents N0 and N1.
+    static CubicHermiteCurve2d FromTangents(const glm::vec2& P0, const glm::vec2& P1, const glm::vec2& N0, const glm::vec2& N1);
+
+    using Bezier::Eval;
+    void Eval(std::span<const float> u, std::span<glm::vec2> pts) const;
+
+    // Exact bounds, the tangents can take the curve outside of the box of its end points.
+    BoundingBox2d GetBounds() const;
+};
@@ -2,13 +2,14 @@
 
 #include "../cubic_hermite_spline_2d/cubic_hermite_spline_2d.h"
 #include "../cubic_bezier_spline_2d/cubic_bezier_spline_2d.h"
+#include "../cubic_polynomial_2d/cubic_polynomial_2d.h"
 
-const double epsilon = std::numeric_limits<double>::epsilon();
-
-CubicHermiteSpline2d::CubicHermiteSpline2d(const std::vector< glm::vec2 >& ctrl_pts)
+CubicHermiteSpline2d::CubicHermiteSpline2d(std::span<const glm::vec2> ctrl_pts)
 {
     assert(ctrl_pts.size() % 4 == 0);
 
+    m_curves.reserve(ctrl_pts.size() / 4);
+
     for (size_t i = 0; i < ctrl_pts.size(); i += 4)
     {
         m_curves.emplace_back(ctrl_pts[i], ctrl_pts[i + 1], ctrl_pts[i + 2], ctrl_pts[i + 3]);
@@ -26,7 +27,7 @@ CubicHermiteSpline2d::CubicHermiteSpline2d
 
     for (size_t i = 0; i < ctrl_pts.size(); i += 2)
     {
-        m_curves.emplace_back(ctrl_pts[i], ctrl_pts[i + 1], tangent_vectors[i], tangent_vectors[i + 1]);
+        m_curves.push_back(CubicHermiteCurve2d::FromTangents(ctrl_pts[i], ctrl_pts[i + 1], tangent_vectors[i], tangent_vectors[i + 1]));
     }
 }
 
@@ -97,42 +98,38 @@ bool CubicHermiteSpline2d::IsC2Continuous() const
 
 glm::vec2 CubicHermiteSpline2d::Eval(double t) const
 {
-    if (t <= 0.0)
-    {
-        return m_curves.front().P0;
-    }
-    else if (1.0 <= t + epsilon)
-    {
-        return m_curves.back().P1;
-    }
-
-    t = std::max(t, 0.0);
-    t = std::min(t, 1.0);
-    t *= static_cast<double>(m_curves.size());
-    double t_decimal = t - static_cast<int>(t);
-    int t_integer = t - t_decimal;
+    const auto [curve, u] = CubicPolynomial2d::FindPiece(m_curves.size(), t);
+    return m_curves[curve].Eval(u);
+}
 
-    return m_curves[t_integer].Eval(t_decimal);
+void CubicHermiteSpline2d::Eval(std::span<const double> t, std::span<glm::vec2> pts) const
+{
+    auto get_curve = [this](size_t i)
+        {
+            const std::array<glm::vec2, 4>& P = m_curves[i].P;
+            return CubicPolynomial2d::FromBezier(P[0], P[1], P[2], P[3]);
+        };
+    CubicPolynomial2d::EvalPiecewise(m_curves.size(), get_curve, m_curves.front().P[0], m_curves.back().P[3], t, pts);
 }
 
 glm::vec2 CubicHermiteSpline2d::EvalFirstDerivative(double t) const
 {
-    t = std::max(t, 0.);
-    t = std::min(t, 1. - epsilon);
-    t *= static_cast<double>(m_curves.size());
-    double t_decimal = t - static_cast<int>(t);
-    int t_integer = t - t_decimal;
-
-    return m_curves[t_integer].EvalFirstDerivative(t_decimal);
+    const auto [curve, u] = CubicPolynomial2d::FindPiece(m_curves.size(), t);
+    return m_curves[curve].EvalFirstDerivative(u);
 }
 
 glm::vec2 CubicHermiteSpline2d::EvalSecondDerivative(double t) const
 {
-    t = std::max(t, 0.);
-    t = std::min(t, 1. - epsilon);
-    t *= static_cast<double>(m_curves.size());
-    double t_decimal = t - static_cast<int>(t);
-    int t_integer = t - t_decimal;
-
-    return m_curves[t_integer].EvalSecondDerivative(t_decimal);
-}
\ No newline at end of file
+    const auto [curve, u] = CubicPolynomial2d::FindPiece(m_curves.size(), t);
+    return m_curves[curve].EvalSecondDerivative(u);
+}
+
+BoundingBox2d CubicHermiteSpline2d::GetBounds() const
+{
+    BoundingBox2d box;
+    for (const auto& curve : m_curves)
+    {
+        box.Extend(curve.GetBounds());
+    }
+    return box;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <span>
 #include <vector>
 
 #include "../cubic_hermite_curve_2d/cubic_hermite_curve_2d.h"
@@ -11,13 +12,14 @@ class CubicBezierSpline2d;
 class CubicHermiteSpline2d
 {
 public:
-    explicit CubicHermiteSpline2d(const std::vector< glm::vec2 >& ctrl_pts);
+    explicit CubicHermiteSpline2d(std::span<const glm::vec2> ctrl_pts);
     CubicHermiteSpline2d(const std::vector< glm::vec2 >& ctrl_pts, const std::vector< glm::vec2 >& tangent_vectors);
 
     static CubicHermiteSpline2d FromCubicBezierSpline2d(const CubicBezierSpline2d& cubic_bezier_spline_2d);
     //static CubicHermiteSpline2d FromCubicBSpline2d(const CubicBSpline2d& cubic_bspline_2d);
 
     glm::vec2 Eval(double t) const;
+    void Eval(std::span<const double> t, std::span<glm::vec2> pts) const;
     glm::vec2 EvalFirstDerivative(double t) const;
     glm::vec2 EvalSecondDerivative(double t) const;
 
@@ -27,5 +29,7 @@ public:
     bool IsC1Continuous() const;
     bool IsC2Continuous() const;
 
+    BoundingBox2d GetBounds() const;
+
     std::vector< CubicHermiteCurve2d > m_curves;
 };
\ No newline at end of file
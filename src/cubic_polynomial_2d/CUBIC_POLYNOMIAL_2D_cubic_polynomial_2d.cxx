@@ -0,0 +1,97 @@
+#include "../cubic_polynomial_2d/cubic_polynomial_2d.h"
+
+#include <algorithm>
+
+CubicPolynomial2d CubicPolynomial2d::FromBezier
+(
+    const glm::vec2& P0,
+    const glm::vec2& P1,
+    const glm::vec2& P2,
+    const glm::vec2& P3
+)
+{
+    return
+    {
+        -P0 + 3.f * P1 - 3.f * P2 + P3,
+        3.f * P0 - 6.f * P1 + 3.f * P2,
+        -3.f * P0 + 3.f * P1,
+        P0
+    };
+}
+
+std::pair<size_t, float> CubicPolynomial2d::FindPiece
+(
+    size_t nb_pieces,
+    double t
+)
+{
+    assert(nb_pieces > 0);
+
+    if (!(t > 0.0))
+    {
+        return { 0, 0.f };
+    }
+    if (t >= 1.0)
+    {
+        return { nb_pieces - 1, 1.f };
+    }
+
+    const double x = t * static_cast<double>(nb_pieces);
+    const size_t piece = std::min(static_cast<size_t>(x), nb_pieces - 1);
+    return { piece, static_cast<float>(x - static_cast<double>(piece)) };
+}
+
+glm::vec2 CubicPolynomial2d::Eval(float u) const
+{
+    return ((A * u + B) * u + C) * u + D;
+}
+
+void CubicPolynomial2d::Eval(std::span<const float> u, std::span<glm::vec2> pts) const
+{
+    assert(u.size() == pts.size());
+
+    size_t i = 0;
+#ifdef SPLINE_USE_SSE2
+    // One lane per parameter, x and y evaluated separately then interleaved back into pts.
+    const __m128 Ax = _mm_set1_ps(A.x), Bx = _mm_set1_ps(B.x), Cx = _mm_set1_ps(C.x), Dx = _mm_set1_ps(D.x);
+    const __m128 Ay = _mm_set1_ps(A.y), By = _mm_set1_ps(B.y), Cy = _mm_set1_ps(C.y), Dy = _mm_set1_ps(D.y);
+    float* out = reinterpret_cast<float*>(pts.data());
+    for (; i + lane_width <= u.size(); i += lane_width)
+    {
+        const __m128 v = _mm_loadu_ps(u.data() + i);
+        const __m128 x = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(Ax, v), Bx), v), Cx), v), Dx);
+        const __m128 y = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(Ay, v), By), v), Cy), v), Dy);
+        _mm_storeu_ps(out + 2 * i, _mm_unpacklo_ps(x, y));
+        _mm_storeu_ps(out + 2 * i + lane_width, _mm_unpackhi_ps(x, y));
+    }
+#endif
+    for (; i < u.size(); ++i)
+    {
+        pts[i] = Eval(u[i]);
+    }
+}
+
+void CubicPolynomial2d::ForwardDifference(double u0, double h, std::span<glm::vec2> pts) const
+{
+    const glm::dvec2 a(A), b(B), c(C), d(D);
+
+    for (size_t i = 0; i < pts.size(); i += reseed_interval)
+    {
+        const double u = u0 + static_cast<double>(i) * h;
+
+        // p(u), p(u + h) - p(u) and the second and third differences, exact at the seed.
+        glm::vec2 p = ((a * u + b) * u + c) * u + d;
+        glm::vec2 d1 = a * (3.0 * u * u * h + 3.0 * u * h * h + h * h * h) + b * (2.0 * u * h + h * h) + c * h;
+        glm::vec2 d2 = a * (6.0 * u * h * h + 6.0 * h * h * h) + b * (2.0 * h * h);
+        const glm::vec2 d3 = a * (6.0 * h * h * h);
+
+        const size_t end = std::min(i + reseed_interval, pts.size());
+        for (size_t j = i; j < end; ++j)
+        {
+            pts[j] = p;
+            p += d1;
+            d1 += d2;
+            d2 += d3;
+        }
+    }
+}
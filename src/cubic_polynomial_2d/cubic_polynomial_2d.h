@@ -0,0 +1,137 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SPLINE_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+// Power basis form A u^3 + B u^2 + C u + D of a cubic curve segment, used by
+// the batched evaluation paths of the curve and spline classes.
+class CubicPolynomial2d
+{
+public:
+    // Number of parameters evaluated together in structure-of-arrays lanes.
+    static constexpr size_t lane_width = 4;
+    // Maximum number of parameters grouped in a single run of EvalPiecewise.
+    static constexpr size_t run_capacity = 16 * lane_width;
+    // Number of points stepped by ForwardDifference before its differences are recomputed.
+    static constexpr size_t reseed_interval = 256;
+
+    static CubicPolynomial2d FromBezier(const glm::vec2& P0, const glm::vec2& P1, const glm::vec2& P2, const glm::vec2& P3);
+
+    glm::vec2 Eval(float u) const;
+    void Eval(std::span<const float> u, std::span<glm::vec2> pts) const;
+
+    // Fills pts with the values at u0, u0 + h, u0 + 2h... by cubic forward differencing : three
+    // vector additions per point. Differences are re-seeded in double every reseed_interval points.
+    void ForwardDifference(double u0, double h, std::span<glm::vec2> pts) const;
+
+    // Piece of a spline made of nb_pieces cubics uniformly spread over [0, 1] that t falls on, as
+    // EvalPiecewise finds it, and the parameter of t on the piece : only the difference between
+    // t * nb_pieces and the piece is rounded to float. NaN is the start of the first piece.
+    static std::pair<size_t, float> FindPiece(size_t nb_pieces, double t);
+
+    // Evaluates a spline made of nb_pieces cubics uniformly spread over [0, 1]. Consecutive
+    // parameters falling on the same piece are grouped and evaluated in SoA lanes ;
+    // get_piece(i) returns the CubicPolynomial2d of piece i and is called once per run.
+    template <class GetPiece>
+    static void EvalPiecewise
+    (
+        size_t nb_pieces,
+        GetPiece get_piece,
+        const glm::vec2& front,
+        const glm::vec2& back,
+        std::span<const double> t,
+        std::span<glm::vec2> pts
+    );
+
+    glm::vec2 A;
+    glm::vec2 B;
+    glm::vec2 C;
+    glm::vec2 D;
+};
+
+template <class GetPiece>
+void CubicPolynomial2d::EvalPiecewise
+(
+    size_t nb_pieces,
+    GetPiece get_piece,
+    const glm::vec2& front,
+    const glm::vec2& back,
+    std::span<const double> t,
+    std::span<glm::vec2> pts
+)
+{
+    assert(t.size() == pts.size());
+
+    const double epsilon = std::numeric_limits<double>::epsilon();
+    const auto scale = static_cast<double>(nb_pieces);
+
+    // The piece of a parameter is floor(t * nb_pieces) as in the scalar Eval, whatever run it falls in,
+    // so that splines with gaps between pieces come out the same however t is batched. The bounds of
+    // the pieces are the exact parameters where the rounded product crosses an integer.
+    auto first_parameter_of = [&](size_t piece)
+        {
+            double t_first = static_cast<double>(piece) / scale;
+            while (t_first * scale < static_cast<double>(piece))
+            {
+                t_first = std::nextafter(t_first, 2.0);
+            }
+            while (t_first > 0.0 && std::nextafter(t_first, 0.0) * scale >= static_cast<double>(piece))
+            {
+                t_first = std::nextafter(t_first, 0.0);
+            }
+            return t_first;
+        };
+
+    size_t piece = nb_pieces;
+    double piece_start = 0.0;
+    double piece_end = 0.0;
+    CubicPolynomial2d polynomial{};
+    float u[run_capacity];
+
+    size_t i = 0;
+    while (i < t.size())
+    {
+        // NaN as well, it is on no piece.
+        if (!(t[i] > 0.0))
+        {
+            pts[i++] = front;
+            continue;
+        }
+        if (1.0 <= t[i] + epsilon)
+        {
+            pts[i++] = back;
+            continue;
+        }
+
+        if (t[i] < piece_start || piece_end <= t[i])
+        {
+            piece = std::min(static_cast<size_t>(t[i] * scale), nb_pieces - 1);
+            piece_start = first_parameter_of(piece);
+            piece_end = std::min(first_parameter_of(piece + 1), 1.0 - epsilon);
+            polynomial = get_piece(piece);
+        }
+
+        // The first parameter always belongs to the run, the others while they stay on the piece.
+        u[0] = static_cast<float>(t[i] * scale - static_cast<double>(piece));
+        size_t count = 1;
+        const size_t max_count = std::min(run_capacity, t.size() - i);
+        while (count < max_count && piece_start <= t[i + count] && t[i + count] < piece_end)
+        {
+            u[count] = static_cast<float>(t[i + count] * scale - static_cast<double>(piece));
+            ++count;
+        }
+
+        polynomial.Eval(std::span<const float>(u, count), pts.subspan(i, count));
+        i += count;
+    }
+}
@@ -0,0 +1,309 @@
+#include "../curve_intersection/curve_intersection.h"
+
+#include <algorithm>
+#include <array>
+#include <tuple>
+
+namespace
+{
+    // Enough for curves much longer than the tolerance, deeper subdivisions only happen around
+    // cusps and overlaps.
+    constexpr uint32_t max_depth = 32;
+
+    // Part [u0, u1] of a curve of the pair.
+    struct piece
+    {
+        CubicBezierCurve2d curve;
+        float u0;
+        float u1;
+    };
+
+    struct pair_of_pieces
+    {
+        piece a;
+        piece b;
+        uint32_t depth;
+    };
+
+    // Bounds of the control points, which contain the curve.
+    BoundingBox2d ControlBounds(const CubicBezierCurve2d& curve)
+    {
+        const std::array<glm::vec2, 4>& P = curve.P;
+        return BoundingBox2d(glm::min(glm::min(P[0], P[1]), glm::min(P[2], P[3])), glm::max(glm::max(P[0], P[1]), glm::max(P[2], P[3])));
+    }
+
+    // Distance of the curve to its chord at the same parameter is at most the larger distance of
+    // P1 and P2 to the chord points at 1/3 and 2/3, so a flat piece can be replaced by its chord.
+    bool IsFlat(const CubicBezierCurve2d& curve, float tolerance)
+    {
+        const std::array<glm::vec2, 4>& P = curve.P;
+        const glm::vec2 d1 = P[1] - glm::mix(P[0], P[3], 1.f / 3.f);
+        const glm::vec2 d2 = P[2] - glm::mix(P[0], P[3], 2.f / 3.f);
+        return std::max(glm::dot(d1, d1), glm::dot(d2, d2)) <= tolerance * tolerance;
+    }
+
+    float Cross(const glm::vec2& a, const glm::vec2& b)
+    {
+        return a.x * b.y - a.y * b.x;
+    }
+
+    // Fat line of Bezier clipping : the band along the chord of a that holds its control points,
+    // and so the curve. b misses a when its control points, and so b, are all on one side of it.
+    bool IsOutsideFatLine(const CubicBezierCurve2d& a, const CubicBezierCurve2d& b, float tolerance)
+    {
+        const glm::vec2 chord = a.P[3] - a.P[0];
+        const float length = glm::length(chord);
+        if (length <= tolerance)
+        {
+            return false;
+        }
+
+        const glm::vec2 normal = glm::vec2(-chord.y, chord.x) / length;
+        const float d1 = glm::dot(a.P[1] - a.P[0], normal);
+        const float d2 = glm::dot(a.P[2] - a.P[0], normal);
+        const float d_min = std::min({ 0.f, d1, d2 }) - tolerance;
+        const float d_max = std::max({ 0.f, d1, d2 }) + tolerance;
+
+        bool is_below = true;
+        bool is_above = true;
+        for (const glm::vec2& P : b.P)
+        {
+            const float d = glm::dot(P - a.P[0], normal);
+            is_below = is_below && d < d_min;
+            is_above = is_above && d > d_max;
+        }
+        return is_below || is_above;
+    }
+
+    // The tangents of a curve are within the cone of its control polygon edges. When every tangent
+    // of a turns the same way towards every tangent of b, the curves cross at most once.
+    bool AreTangentConesDisjoint(const CubicBezierCurve2d& a, const CubicBezierCurve2d& b)
+    {
+        bool is_positive = true;
+        bool is_negative = true;
+        for (size_t i = 0; i < 3; ++i)
+        {
+            const glm::vec2 ta = a.P[i + 1] - a.P[i];
+            for (size_t j = 0; j < 3; ++j)
+            {
+                const float cross = Cross(ta, b.P[j + 1] - b.P[j]);
+                is_positive = is_positive && cross > 0.f;
+                is_negative = is_negative && cross < 0.f;
+            }
+        }
+        return is_positive || is_negative;
+    }
+
+    // Parameters of the crossing of the chords, within a little slack so that crossings at the end
+    // of a piece are not lost to rounding. Parallel chords have none.
+    bool IntersectChords(const CubicBezierCurve2d& a, const CubicBezierCurve2d& b, float& s, float& u)
+    {
+        constexpr float slack = 1e-4f;
+
+        const glm::vec2 da = a.P[3] - a.P[0];
+        const glm::vec2 db = b.P[3] - b.P[0];
+        const float det = Cross(da, db);
+        if (det * det <= 1e-12f * glm::dot(da, da) * glm::dot(db, db))
+        {
+            return false;
+        }
+
+        const glm::vec2 d = b.P[0] - a.P[0];
+        s = Cross(d, db) / det;
+        u = Cross(d, da) / det;
+        return -slack <= s && s <= 1.f + slack && -slack <= u && u <= 1.f + slack;
+    }
+
+    // Newton's method on a(s) - b(u) = 0 from the crossing of the chords.
+    bool RefineCrossing(const CubicBezierCurve2d& a, const CubicBezierCurve2d& b, float tolerance, float& s, float& u)
+    {
+        constexpr int nb_iterations = 4;
+
+        for (int i = 0; i < nb_iterations; ++i)
+        {
+            const glm::vec2 f = a.Eval(s) - b.Eval(u);
+            if (glm::dot(f, f) <= 1e-4f * tolerance * tolerance)
+            {
+                break;
+            }
+
+            const glm::vec2 da = a.EvalFirstDerivative(s);
+            const glm::vec2 db = b.EvalFirstDerivative(u);
+            const float det = Cross(da, db);
+            if (det == 0.f)
+            {
+                return false;
+            }
+            s = std::clamp(s - Cross(f, db) / det, 0.f, 1.f);
+            u = std::clamp(u + Cross(da, f) / det, 0.f, 1.f);
+        }
+
+        const glm::vec2 f = a.Eval(s) - b.Eval(u);
+        return glm::dot(f, f) <= tolerance * tolerance;
+    }
+}
+
+void CurveIntersection::Intersect
+(
+    const CubicBezierCurve2d& a,
+    const CubicBezierCurve2d& b,
+    float tolerance,
+    std::vector<CurveHit>& hits
+)
+{
+    // Pieces that cross at most once are refined by Newton's method from the crossing of their
+    // chords. Near tangent crossings, where it does not converge, are subdivided until both pieces
+    // are within a quarter of the tolerance of their chord, whose crossing is then within tolerance
+    // of both curves.
+    const float flatness = 0.25f * tolerance;
+    const size_t first_hit = hits.size();
+
+    auto add_hit = [&](float u_a, float u_b)
+        {
+            const glm::vec2 point = 0.5f * (a.Eval(u_a) + b.Eval(u_b));
+            const bool is_known = std::any_of(hits.begin() + static_cast<std::ptrdiff_t>(first_hit), hits.end(), [&](const CurveHit& hit)
+                {
+                    const glm::vec2 d = hit.point - point;
+                    return glm::dot(d, d) <= tolerance * tolerance;
+                });
+            if (!is_known)
+            {
+                hits.push_back({ u_a, u_b, point });
+            }
+        };
+
+    thread_local std::vector<pair_of_pieces> stack;
+    stack.clear();
+    stack.push_back({ { a, 0.f, 1.f }, { b, 0.f, 1.f }, 0 });
+    while (!stack.empty())
+    {
+        const pair_of_pieces pair = stack.back();
+        stack.pop_back();
+
+        const BoundingBox2d box_a = ControlBounds(pair.a.curve);
+        const BoundingBox2d box_b = ControlBounds(pair.b.curve);
+        if (!box_a.Inflated(tolerance).Overlaps(box_b)
+            || IsOutsideFatLine(pair.a.curve, pair.b.curve, tolerance)
+            || IsOutsideFatLine(pair.b.curve, pair.a.curve, tolerance))
+        {
+            continue;
+        }
+
+        float s;
+        float u;
+        if (AreTangentConesDisjoint(pair.a.curve, pair.b.curve) && IntersectChords(pair.a.curve, pair.b.curve, s, u))
+        {
+            float u_a = glm::mix(pair.a.u0, pair.a.u1, std::clamp(s, 0.f, 1.f));
+            float u_b = glm::mix(pair.b.u0, pair.b.u1, std::clamp(u, 0.f, 1.f));
+            if (RefineCrossing(a, b, tolerance, u_a, u_b))
+            {
+                add_hit(u_a, u_b);
+                continue;
+            }
+        }
+
+        const bool is_a_flat = IsFlat(pair.a.curve, flatness);
+        const bool is_b_flat = IsFlat(pair.b.curve, flatness);
+        if ((is_a_flat && is_b_flat) || pair.depth == max_depth)
+        {
+            if (IntersectChords(pair.a.curve, pair.b.curve, s, u))
+            {
+                add_hit(glm::mix(pair.a.u0, pair.a.u1, std::clamp(s, 0.f, 1.f)), glm::mix(pair.b.u0, pair.b.u1, std::clamp(u, 0.f, 1.f)));
+            }
+            continue;
+        }
+
+        // Splits the curve that is not flat yet, the larger one when both are not.
+        const glm::vec2 size_a = box_a.GetSize();
+        const glm::vec2 size_b = box_b.GetSize();
+        const bool split_a = !is_a_flat && (is_b_flat || std::max(size_a.x, size_a.y) >= std::max(size_b.x, size_b.y));
+        const piece& split = split_a ? pair.a : pair.b;
+        const auto [first, second] = split.curve.Subdivide(0.5f);
+        const float u_mid = 0.5f * (split.u0 + split.u1);
+        const piece first_piece = { first, split.u0, u_mid };
+        const piece second_piece = { second, u_mid, split.u1 };
+        if (split_a)
+        {
+            stack.push_back({ second_piece, pair.b, pair.depth + 1 });
+            stack.push_back({ first_piece, pair.b, pair.depth + 1 });
+        }
+        else
+        {
+            stack.push_back({ pair.a, second_piece, pair.depth + 1 });
+            stack.push_back({ pair.a, first_piece, pair.depth + 1 });
+        }
+    }
+}
+
+std::vector<CurveIntersection::Intersection> CurveIntersection::FindIntersections
+(
+    std::span<const SegmentBvh2d::Segment> segments,
+    float tolerance
+)
+{
+    // Sweep along x over the segment bounds, each box is tested against the boxes starting before
+    // its end. The bounds are copied apart from the curves for the sweep to read them in order.
+    struct swept_box
+    {
+        float min_x;
+        float max_x;
+        float min_y;
+        float max_y;
+        uint32_t segment;
+        uint32_t spline;
+    };
+
+    std::vector<swept_box> boxes(segments.size());
+    for (size_t i = 0; i < segments.size(); ++i)
+    {
+        const BoundingBox2d box = segments[i].curve.GetBounds().Inflated(0.5f * tolerance);
+        boxes[i] = { box.min.x, box.max.x, box.min.y, box.max.y, static_cast<uint32_t>(i), segments[i].spline };
+    }
+    std::ranges::sort(boxes, {}, &swept_box::min_x);
+
+    std::vector<Intersection> intersections;
+    std::vector<CurveHit> hits;
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+        const swept_box box = boxes[i];
+        for (size_t j = i + 1; j < boxes.size() && boxes[j].min_x <= box.max_x; ++j)
+        {
+            // Most boxes are rejected here, the tests are combined without branching.
+            const swept_box& other = boxes[j];
+            if (!((box.min_y <= other.max_y) & (other.min_y <= box.max_y) & (box.spline != other.spline)))
+            {
+                continue;
+            }
+
+            const SegmentBvh2d::Segment* a = &segments[box.segment];
+            const SegmentBvh2d::Segment* b = &segments[other.segment];
+            if (a->spline > b->spline)
+            {
+                std::swap(a, b);
+            }
+
+            hits.clear();
+            Intersect(a->curve, b->curve, tolerance, hits);
+            for (const CurveHit& hit : hits)
+            {
+                intersections.push_back({
+                    a->spline, a->index, a->t0 + (a->t1 - a->t0) * hit.u_a,
+                    b->spline, b->index, b->t0 + (b->t1 - b->t0) * hit.u_b,
+                    hit.point });
+            }
+        }
+    }
+
+    // A crossing at a joint is found on both segments around it, one after the other once sorted.
+    auto key = [](const Intersection& intersection) { return std::tie(intersection.spline_a, intersection.spline_b, intersection.t_a); };
+    std::ranges::sort(intersections, {}, key);
+    auto is_duplicate = [&](const Intersection& previous, const Intersection& next)
+        {
+            const glm::vec2 d = next.point - previous.point;
+            return previous.spline_a == next.spline_a && previous.spline_b == next.spline_b && glm::dot(d, d) <= tolerance * tolerance;
+        };
+    const auto duplicates = std::ranges::unique(intersections, is_duplicate);
+    intersections.erase(duplicates.begin(), duplicates.end());
+
+    return intersections;
+}
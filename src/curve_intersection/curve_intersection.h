@@ -0,0 +1,43 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "../cubic_bezier_curve_2d/cubic_bezier_curve_2d.h"
+#include "../segment_bvh_2d/segment_bvh_2d.h"
+
+// Crossings between cubic Bezier curves, and between every pair of splines of a set of segments.
+// Pairs of segments are found by sweep and prune over their bounds, each pair is then subdivided
+// until both halves are within tolerance of a line and their chords are intersected.
+namespace CurveIntersection
+{
+    // Parameters on either curve, both of them within tolerance of point.
+    struct CurveHit
+    {
+        float u_a;
+        float u_b;
+        glm::vec2 point;
+    };
+
+    // Parameters on the splines, spline_a < spline_b.
+    struct Intersection
+    {
+        uint32_t spline_a;
+        uint32_t segment_a;
+        double t_a;
+        uint32_t spline_b;
+        uint32_t segment_b;
+        double t_b;
+        glm::vec2 point;
+    };
+
+    // Appends the crossings of a and b, hits closer than tolerance to each other are reported once.
+    // Overlapping parts of the curves have no single crossing, they give hits all along the overlap.
+    void Intersect(const CubicBezierCurve2d& a, const CubicBezierCurve2d& b, float tolerance, std::vector<CurveHit>& hits);
+
+    // Crossings between segments of different splines, sorted by splines then by t_a. A crossing at
+    // the joint of two segments is reported once.
+    std::vector<Intersection> FindIntersections(std::span<const SegmentBvh2d::Segment> segments, float tolerance);
+};
@@ -1,4 +1,193 @@
 #include "../discretization/discretization.h"
+#include "../cubic_polynomial_2d/cubic_polynomial_2d.h"
+
+namespace
+{
+    template <class T>
+    std::vector<T> UniformParameters(uint32_t nb_pts)
+    {
+        assert(nb_pts >= 2);
+
+        std::vector<T> parameters(nb_pts);
+        double t_step = 1.0 / ((int32_t)nb_pts - 1);
+        for (uint32_t i = 0; i < nb_pts; ++i)
+        {
+            parameters[i] = static_cast<T>(std::min(i * t_step, 1.0));
+        }
+        return parameters;
+    }
+
+    // Pieces of a spline of equal width in t, as the curves of Bezier and Hermite splines.
+    struct uniform_pieces
+    {
+        size_t nb_pieces;
+
+        size_t Find(double t) const { return std::min(static_cast<size_t>(t * static_cast<double>(nb_pieces)), nb_pieces - 1); }
+        double GetStart(size_t piece) const { return static_cast<double>(piece) / static_cast<double>(nb_pieces); }
+    };
+
+    // Knot spans of a B-spline, the empty ones included so that piece k is span k + 3.
+    struct knot_span_pieces
+    {
+        const CubicBSpline2d& spline;
+
+        size_t Find(double t) const { return spline.FindSpan(t) - 3; }
+        double GetStart(size_t piece) const { return spline.m_knots[piece + 3]; }
+    };
+
+    // Forward differencing of the uniform samples t = i / (nb_pts - 1), i from first to
+    // first + pts.size() - 1, over a spline made of cubic pieces : the samples on a piece are
+    // stepped from the first of them. get_piece(k) returns the CubicPolynomial2d of piece k over
+    // [0, 1] and is called once per run.
+    template <class Pieces, class GetPiece>
+    void ForwardDifferencingPiecewise
+    (
+        const Pieces& pieces,
+        GetPiece get_piece,
+        const glm::vec2& front,
+        const glm::vec2& back,
+        uint32_t nb_pts,
+        size_t first,
+        std::span<glm::vec2> pts
+    )
+    {
+        assert(nb_pts >= 2 && first + pts.size() <= nb_pts);
+
+        const double epsilon = std::numeric_limits<double>::epsilon();
+        const double t_step = 1.0 / ((int32_t)nb_pts - 1);
+        const size_t last = first + pts.size();
+
+        auto parameter = [&](size_t i) { return std::min(static_cast<double>(i) * t_step, 1.0); };
+
+        size_t i = first;
+        while (i < last)
+        {
+            const double t = parameter(i);
+            if (t <= 0.0)
+            {
+                pts[i++ - first] = front;
+                continue;
+            }
+            if (1.0 <= t + epsilon)
+            {
+                pts[i++ - first] = back;
+                continue;
+            }
+
+            // Guess the end of the run from the piece bounds, then fix it up against the exact parameters.
+            const size_t piece = pieces.Find(t);
+            const double start = pieces.GetStart(piece);
+            const double end = pieces.GetStart(piece + 1);
+            auto is_on_piece = [&](size_t j) { return parameter(j) < end && parameter(j) + epsilon < 1.0; };
+
+            auto run_end = static_cast<size_t>(std::ceil(end / t_step));
+            run_end = std::clamp(run_end, i + 1, last);
+            while (run_end > i + 1 && !is_on_piece(run_end - 1))
+            {
+                --run_end;
+            }
+            while (run_end < last && is_on_piece(run_end))
+            {
+                ++run_end;
+            }
+
+            const double width = end - start;
+            get_piece(piece).ForwardDifference((t - start) / width, t_step / width, pts.subspan(i - first, run_end - i));
+            i = run_end;
+        }
+    }
+
+    void ForwardDifferencingRange(const CubicBezierSpline2d& spline, uint32_t nb_pts, size_t first, std::span<glm::vec2> pts)
+    {
+        const std::vector<CubicBezierCurve2d>& curves = spline.m_curves;
+        auto get_curve = [&](size_t i)
+            {
+                const std::array<glm::vec2, 4>& P = curves[i].P;
+                return CubicPolynomial2d::FromBezier(P[0], P[1], P[2], P[3]);
+            };
+
+        ForwardDifferencingPiecewise(uniform_pieces{ curves.size() }, get_curve, curves.front().P[0], curves.back().P[3], nb_pts, first, pts);
+    }
+
+    void ForwardDifferencingRange(const CubicHermiteSpline2d& spline, uint32_t nb_pts, size_t first, std::span<glm::vec2> pts)
+    {
+        const std::vector<CubicHermiteCurve2d>& curves = spline.m_curves;
+        auto get_curve = [&](size_t i)
+            {
+                const std::array<glm::vec2, 4>& P = curves[i].P;
+                return CubicPolynomial2d::FromBezier(P[0], P[1], P[2], P[3]);
+            };
+
+        ForwardDifferencingPiecewise(uniform_pieces{ curves.size() }, get_curve, curves.front().P[0], curves.back().P[3], nb_pts, first, pts);
+    }
+
+    void ForwardDifferencingRange(const CubicBSpline2d& spline, uint32_t nb_pts, size_t first, std::span<glm::vec2> pts)
+    {
+        auto get_span = [&](size_t i)
+            {
+                const CubicBezierCurve2d curve = spline.GetSpanBezierCurve(i + 3);
+                return CubicPolynomial2d::FromBezier(curve.P[0], curve.P[1], curve.P[2], curve.P[3]);
+            };
+
+        ForwardDifferencingPiecewise(knot_span_pieces{ spline }, get_span, spline.m_ctrl_pts.front(), spline.m_ctrl_pts.back(), nb_pts, first, pts);
+    }
+
+    template <class Spline>
+    std::vector<glm::vec2> ArcLengthPiecewise(ArcLengthTable<Spline> const& arcLengthTable, uint32_t nb_pts)
+    {
+        std::vector<double> lengths = UniformParameters<double>(nb_pts);
+        for (double& s : lengths)
+        {
+            s *= arcLengthTable.GetLength();
+        }
+
+        std::vector<double> parameters(nb_pts);
+        arcLengthTable.GetParameters(lengths, parameters);
+
+        std::vector<glm::vec2> polylines(nb_pts);
+        arcLengthTable.m_spline.Eval(parameters, polylines);
+        return polylines;
+    }
+
+    constexpr int max_subdivision_depth = 16;
+
+    // The distance between a cubic and its chord is at most 3/4 of the largest second difference
+    // of its control polygon.
+    bool IsFlat(const CubicBezierCurve2d& curve, float tolerance)
+    {
+        const std::array<glm::vec2, 4>& P = curve.P;
+        glm::vec2 d1 = P[0] - 2.f * P[1] + P[2];
+        glm::vec2 d2 = P[1] - 2.f * P[2] + P[3];
+        float max_d = std::max(glm::dot(d1, d1), glm::dot(d2, d2));
+        return 0.5625f * max_d <= tolerance * tolerance;
+    }
+
+    // Appends the end points of the flat pieces of curve, its first point excluded.
+    void AppendAdaptive(const CubicBezierCurve2d& curve, float tolerance, int depth, std::vector<glm::vec2>& polylines)
+    {
+        if (depth >= max_subdivision_depth || IsFlat(curve, tolerance))
+        {
+            polylines.push_back(curve.P[3]);
+            return;
+        }
+
+        auto [left, right] = curve.Subdivide(0.5f);
+        AppendAdaptive(left, tolerance, depth + 1, polylines);
+        AppendAdaptive(right, tolerance, depth + 1, polylines);
+    }
+
+    // Curves of a spline may be disjoint, their first point is only added when it is not the last one.
+    void AppendAdaptiveCurve(const CubicBezierCurve2d& curve, float tolerance, std::vector<glm::vec2>& polylines)
+    {
+        assert(tolerance > 0.f);
+
+        if (polylines.empty() || polylines.back() != curve.P[0])
+        {
+            polylines.push_back(curve.P[0]);
+        }
+        AppendAdaptive(curve, tolerance, 0, polylines);
+    }
+}
 
 std::vector<glm::vec2> Discretization::Linear
 (
@@ -6,16 +195,9 @@ std::vector<glm::vec2> Discretization::Linear
     uint32_t nb_pts
 )
 {
-    std::vector<glm::vec2> polylines;
-
-    assert(nb_pts >= 2);
-    double t_step = 1.0 / ((int32_t)nb_pts - 1);
-    for (uint32_t i = 0; i < nb_pts; ++i)
-    {
-        double t = std::min(i * t_step, 1.0);
-        glm::vec2 pt = cubicBezierCurve2d.Eval(t);
-        polylines.push_back(pt);
-    }
+    std::vector<float> parameters = UniformParameters<float>(nb_pts);
+    std::vector<glm::vec2> polylines(nb_pts);
+    cubicBezierCurve2d.Eval(parameters, polylines);
 
     return polylines;
 }
@@ -26,16 +208,9 @@ std::vector<glm::vec2> Discretization::Linear
     uint32_t nb_pts
 )
 {
-    std::vector<glm::vec2> polylines;
-
-    assert(nb_pts >= 2);
-    double t_step = 1.0 / ((int32_t)nb_pts - 1);
-    for (uint32_t i = 0; i < nb_pts; ++i)
-    {
-        double t = std::min(i * t_step, 1.0);
-        glm::vec2 pt = cubicBezierSpline2d.Eval(t);
-        polylines.push_back(pt);
-    }
+    std::vector<double> parameters = UniformParameters<double>(nb_pts);
+    std::vector<glm::vec2> polylines(nb_pts);
+    cubicBezierSpline2d.Eval(parameters, polylines);
 
     return polylines;
 }
@@ -46,56 +221,249 @@ std::vector<glm::vec2> Discretization::Linear
     uint32_t nb_pts
 )
 {
-    std::vector<glm::vec2> polylines;
+    std::vector<float> parameters = UniformParameters<float>(nb_pts);
+    std::vector<glm::vec2> polylines(nb_pts);
+    cubicHermiteCurve2d.Eval(parameters, polylines);
 
-    assert(nb_pts >= 2);
-    double t_step = 1.0 / ((int32_t)nb_pts - 1);
-    for (uint32_t i = 0; i < nb_pts; ++i)
-    {
-        double t = std::min(i * t_step, 1.0);
-        glm::vec2 pt = cubicHermiteCurve2d.Eval(t);
-        polylines.push_back(pt);
-    }
+    return polylines;
+}
+
+std::vector<glm::vec2> Discretization::Linear
+(
+    CubicHermiteSpline2d const& cubicHermiteSpline2d,
+    uint32_t nb_pts
+)
+{
+    std::vector<double> parameters = UniformParameters<double>(nb_pts);
+    std::vector<glm::vec2> polylines(nb_pts);
+    cubicHermiteSpline2d.Eval(parameters, polylines);
 
     return polylines;
 }
 
 std::vector<glm::vec2> Discretization::Linear
+(
+    CubicBSpline2d const& cubicBSpline2d,
+    uint32_t nb_pts
+)
+{
+    std::vector<double> parameters = UniformParameters<double>(nb_pts);
+    std::vector<glm::vec2> polylines(nb_pts);
+    cubicBSpline2d.Eval(parameters, polylines);
+
+    return polylines;
+}
+
+std::vector<glm::vec2> Discretization::ForwardDifferencing
+(
+    CubicBezierCurve2d const& cubicBezierCurve2d,
+    uint32_t nb_pts
+)
+{
+    assert(nb_pts >= 2);
+
+    const std::array<glm::vec2, 4>& P = cubicBezierCurve2d.P;
+    std::vector<glm::vec2> polylines(nb_pts);
+    CubicPolynomial2d::FromBezier(P[0], P[1], P[2], P[3]).ForwardDifference(0.0, 1.0 / ((int32_t)nb_pts - 1), polylines);
+
+    return polylines;
+}
+
+std::vector<glm::vec2> Discretization::ForwardDifferencing
+(
+    CubicBezierSpline2d const& cubicBezierSpline2d,
+    uint32_t nb_pts
+)
+{
+    std::vector<glm::vec2> polylines(nb_pts);
+    ForwardDifferencingRange(cubicBezierSpline2d, nb_pts, 0, polylines);
+
+    return polylines;
+}
+
+std::vector<glm::vec2> Discretization::ForwardDifferencing
+(
+    CubicBSpline2d const& cubicBSpline2d,
+    uint32_t nb_pts
+)
+{
+    std::vector<glm::vec2> polylines(nb_pts);
+    ForwardDifferencingRange(cubicBSpline2d, nb_pts, 0, polylines);
+
+    return polylines;
+}
+
+std::vector<glm::vec2> Discretization::ForwardDifferencing
+(
+    CubicHermiteCurve2d const& cubicHermiteCurve2d,
+    uint32_t nb_pts
+)
+{
+    assert(nb_pts >= 2);
+
+    const std::array<glm::vec2, 4>& P = cubicHermiteCurve2d.P;
+    std::vector<glm::vec2> polylines(nb_pts);
+    CubicPolynomial2d::FromBezier(P[0], P[1], P[2], P[3]).ForwardDifference(0.0, 1.0 / ((int32_t)nb_pts - 1), polylines);
+
+    return polylines;
+}
+
+std::vector<glm::vec2> Discretization::ForwardDifferencing
 (
     CubicHermiteSpline2d const& cubicHermiteSpline2d,
     uint32_t nb_pts
 )
+{
+    std::vector<glm::vec2> polylines(nb_pts);
+    ForwardDifferencingRange(cubicHermiteSpline2d, nb_pts, 0, polylines);
+
+    return polylines;
+}
+
+void Discretization::ForwardDifferencing
+(
+    CubicBSpline2d const& cubicBSpline2d,
+    uint32_t nb_pts,
+    size_t first,
+    std::span<glm::vec2> pts
+)
+{
+    ForwardDifferencingRange(cubicBSpline2d, nb_pts, first, pts);
+}
+
+void Discretization::ForwardDifferencing
+(
+    CubicBezierSpline2d const& cubicBezierSpline2d,
+    uint32_t nb_pts,
+    size_t first,
+    std::span<glm::vec2> pts
+)
+{
+    ForwardDifferencingRange(cubicBezierSpline2d, nb_pts, first, pts);
+}
+
+void Discretization::ForwardDifferencing
+(
+    CubicHermiteSpline2d const& cubicHermiteSpline2d,
+    uint32_t nb_pts,
+    size_t first,
+    std::span<glm::vec2> pts
+)
+{
+    ForwardDifferencingRange(cubicHermiteSpline2d, nb_pts, first, pts);
+}
+
+std::vector<glm::vec2> Discretization::Adaptive
+(
+    CubicBSpline2d const& cubicBSpline2d,
+    float tolerance
+)
+{
+    return Adaptive(CubicBezierSpline2d::FromCubicBSpline2d(cubicBSpline2d), tolerance);
+}
+
+std::vector<glm::vec2> Discretization::Adaptive
+(
+    CubicBezierCurve2d const& cubicBezierCurve2d,
+    float tolerance
+)
 {
     std::vector<glm::vec2> polylines;
+    AppendAdaptiveCurve(cubicBezierCurve2d, tolerance, polylines);
 
-    assert(nb_pts >= 2);
-    double t_step = 1.0 / ((int32_t)nb_pts - 1);
-    for (uint32_t i = 0; i < nb_pts; ++i)
+    return polylines;
+}
+
+std::vector<glm::vec2> Discretization::Adaptive
+(
+    CubicBezierSpline2d const& cubicBezierSpline2d,
+    float tolerance
+)
+{
+    std::vector<glm::vec2> polylines;
+    for (const CubicBezierCurve2d& curve : cubicBezierSpline2d.m_curves)
     {
-        double t = std::min(i * t_step, 1.0);
-        glm::vec2 pt = cubicHermiteSpline2d.Eval(t);
-        polylines.push_back(pt);
+        AppendAdaptiveCurve(curve, tolerance, polylines);
     }
 
     return polylines;
 }
 
-std::vector<glm::vec2> Discretization::Linear
+std::vector<glm::vec2> Discretization::Adaptive
 (
-    CubicBSpline2d const& cubicBSpline2d,
-    uint32_t nb_pts
+    CubicHermiteCurve2d const& cubicHermiteCurve2d,
+    float tolerance
 )
 {
     std::vector<glm::vec2> polylines;
+    AppendAdaptiveCurve(CubicBezierCurve2d::FromCubicHermiteCurve2d(cubicHermiteCurve2d), tolerance, polylines);
 
-    assert(nb_pts >= 2);
-    double t_step = 1.0 / ((int32_t)nb_pts - 1);
-    for (uint32_t i = 0; i < nb_pts; ++i)
+    return polylines;
+}
+
+std::vector<glm::vec2> Discretization::Adaptive
+(
+    CubicHermiteSpline2d const& cubicHermiteSpline2d,
+    float tolerance
+)
+{
+    std::vector<glm::vec2> polylines;
+    for (const CubicHermiteCurve2d& curve : cubicHermiteSpline2d.m_curves)
     {
-        double t = std::min( i * t_step, 1.0 );
-        glm::vec2 pt = cubicBSpline2d.Eval(t);
-        polylines.push_back(pt);
+        AppendAdaptiveCurve(CubicBezierCurve2d::FromCubicHermiteCurve2d(curve), tolerance, polylines);
     }
 
     return polylines;
-}
\ No newline at end of file
+}
+
+std::vector<glm::vec2> Discretization::ArcLength
+(
+    ArcLengthTable<CubicBSpline2d> const& arcLengthTable,
+    uint32_t nb_pts
+)
+{
+    return ArcLengthPiecewise(arcLengthTable, nb_pts);
+}
+
+std::vector<glm::vec2> Discretization::ArcLength
+(
+    ArcLengthTable<CubicBezierSpline2d> const& arcLengthTable,
+    uint32_t nb_pts
+)
+{
+    return ArcLengthPiecewise(arcLengthTable, nb_pts);
+}
+
+std::vector<glm::vec2> Discretization::ArcLength
+(
+    ArcLengthTable<CubicHermiteSpline2d> const& arcLengthTable,
+    uint32_t nb_pts
+)
+{
+    return ArcLengthPiecewise(arcLengthTable, nb_pts);
+}
+
+Discretization::AccuracyReport Discretization::MeasureAccuracy
+(
+    std::span<const glm::vec2> reference,
+    std::span<const glm::vec2> pts
+)
+{
+    assert(reference.size() == pts.size());
+
+    AccuracyReport report;
+    double sum = 0.0;
+    for (size_t i = 0; i < pts.size(); ++i)
+    {
+        float error = glm::length(pts[i] - reference[i]);
+        sum += error;
+        if (error > report.max_error)
+        {
+            report.max_error = error;
+            report.max_error_index = i;
+        }
+    }
+    report.mean_error = pts.empty() ? 0.f : static_cast<float>(sum / static_cast<double>(pts.size()));
+
+    return report;
+}
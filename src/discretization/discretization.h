@@ -3,6 +3,9 @@
 #include "../cubic_bezier_spline_2d/cubic_bezier_spline_2d.h"
 #include "../cubic_hermite_spline_2d/cubic_hermite_spline_2d.h"
 #include "../cubic_bspline_2d/cubic_bspline_2d.h"
+#include "../arc_length_table/arc_length_table.h"
+
+#include <span>
 
 namespace Discretization
 {
@@ -11,4 +14,39 @@ namespace Discretization
     std::vector<glm::vec2> Linear(  CubicBezierSpline2d     const& cubicBezierSpline2d,     uint32_t nb_pts );
     std::vector<glm::vec2> Linear(  CubicHermiteCurve2d     const& cubicHermiteCurve2d,     uint32_t nb_pts );
     std::vector<glm::vec2> Linear(  CubicHermiteSpline2d    const& cubicHermiteSpline2d,    uint32_t nb_pts );
+
+    // Same samples as Linear, computed by forward differencing re-seeded on every curve.
+    std::vector<glm::vec2> ForwardDifferencing( CubicBSpline2d          const& cubicBSpline2d,          uint32_t nb_pts );
+    std::vector<glm::vec2> ForwardDifferencing( CubicBezierCurve2d      const& cubicBezierCurve2d,      uint32_t nb_pts );
+    std::vector<glm::vec2> ForwardDifferencing( CubicBezierSpline2d     const& cubicBezierSpline2d,     uint32_t nb_pts );
+    std::vector<glm::vec2> ForwardDifferencing( CubicHermiteCurve2d     const& cubicHermiteCurve2d,     uint32_t nb_pts );
+    std::vector<glm::vec2> ForwardDifferencing( CubicHermiteSpline2d    const& cubicHermiteSpline2d,    uint32_t nb_pts );
+
+    // Samples first to first + pts.size() - 1 of the above, so that a part of a spline is tessellated
+    // again on its own. B-spline pieces are its knot spans, of any width.
+    void ForwardDifferencing( CubicBSpline2d          const& cubicBSpline2d,          uint32_t nb_pts, size_t first, std::span<glm::vec2> pts );
+    void ForwardDifferencing( CubicBezierSpline2d     const& cubicBezierSpline2d,     uint32_t nb_pts, size_t first, std::span<glm::vec2> pts );
+    void ForwardDifferencing( CubicHermiteSpline2d    const& cubicHermiteSpline2d,    uint32_t nb_pts, size_t first, std::span<glm::vec2> pts );
+
+    // Recursive de Casteljau subdivision until every piece is within tolerance of its chord.
+    std::vector<glm::vec2> Adaptive(    CubicBSpline2d          const& cubicBSpline2d,          float tolerance );
+    std::vector<glm::vec2> Adaptive(    CubicBezierCurve2d      const& cubicBezierCurve2d,      float tolerance );
+    std::vector<glm::vec2> Adaptive(    CubicBezierSpline2d     const& cubicBezierSpline2d,     float tolerance );
+    std::vector<glm::vec2> Adaptive(    CubicHermiteCurve2d     const& cubicHermiteCurve2d,     float tolerance );
+    std::vector<glm::vec2> Adaptive(    CubicHermiteSpline2d    const& cubicHermiteSpline2d,    float tolerance );
+
+    // nb_pts points equally spaced along the curve.
+    std::vector<glm::vec2> ArcLength(   ArcLengthTable<CubicBSpline2d>          const& arcLengthTable,  uint32_t nb_pts );
+    std::vector<glm::vec2> ArcLength(   ArcLengthTable<CubicBezierSpline2d>     const& arcLengthTable,  uint32_t nb_pts );
+    std::vector<glm::vec2> ArcLength(   ArcLengthTable<CubicHermiteSpline2d>    const& arcLengthTable,  uint32_t nb_pts );
+
+    struct AccuracyReport
+    {
+        float max_error = 0.f;
+        float mean_error = 0.f;
+        size_t max_error_index = 0;
+    };
+
+    // Distances between two discretizations of the same curve, e.g. ForwardDifferencing against Linear.
+    AccuracyReport MeasureAccuracy( std::span<const glm::vec2> reference, std::span<const glm::vec2> pts );
 };
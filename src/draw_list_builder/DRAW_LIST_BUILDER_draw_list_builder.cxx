@@ -0,0 +1,331 @@
+#include "../draw_list_builder/draw_list_builder.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+
+namespace
+{
+    // Width of the anti-aliasing fringe, as ImGui's FringeScale of 1.
+    constexpr float aa_size = 1.f;
+
+    glm::vec2 SegmentNormal(const glm::vec2& a, const glm::vec2& b)
+    {
+        const glm::vec2 d = b - a;
+        const float length2 = glm::dot(d, d);
+        return length2 > 0.f ? glm::vec2(d.y, -d.x) / std::sqrt(length2) : glm::vec2(0.f);
+    }
+
+    // Mean of the normals of the two segments at a joint, lengthened so that the stroke keeps its
+    // width around the corner, at most 10 times as ImGui does.
+    glm::vec2 MiterNormal(const glm::vec2& previous, const glm::vec2& next)
+    {
+        glm::vec2 normal = 0.5f * (previous + next);
+        const float length2 = glm::dot(normal, normal);
+        if (length2 > 1e-6f)
+        {
+            normal *= std::min(1.f / length2, 100.f);
+        }
+        return normal;
+    }
+
+    // Same number of segments as ImGui's AddCircleFilled with the default tessellation error.
+    size_t CircleSegmentCount(float radius)
+    {
+        constexpr float max_error = 0.3f;
+        const float count = std::ceil(std::numbers::pi_v<float> / std::acos(1.f - std::min(max_error, radius) / radius));
+        const auto even_count = (static_cast<size_t>(count) + 1) / 2 * 2;
+        return std::clamp<size_t>(even_count, 4, 64);
+    }
+
+    ImDrawVert Vertex(const glm::vec2& position, const ImVec2& uv, ImU32 color)
+    {
+        return { ImVec2(position.x, position.y), uv, color };
+    }
+}
+
+DrawListBuilder::DrawListBuilder()
+    : DrawListBuilder(Style())
+{
+}
+
+DrawListBuilder::DrawListBuilder(const Style& style)
+    : m_style(style)
+{
+    // Polygon marker : a fan over the inner ring, and a fringe out to the outer one.
+    const size_t nb_segments = CircleSegmentCount(std::max(m_style.marker_radius, 1.f));
+    m_marker_offsets.resize(2 * nb_segments);
+    for (size_t i = 0; i < nb_segments; ++i)
+    {
+        const float angle = 2.f * std::numbers::pi_v<float> * static_cast<float>(i) / static_cast<float>(nb_segments);
+        const glm::vec2 direction(std::cos(angle), std::sin(angle));
+        m_marker_offsets[i] = direction * (m_style.marker_radius - 0.5f * aa_size);
+        m_marker_offsets[nb_segments + i] = direction * (m_style.marker_radius + 0.5f * aa_size);
+    }
+    for (size_t i = 2; i < nb_segments; ++i)
+    {
+        m_marker_indices.insert(m_marker_indices.end(), { 0, static_cast<ImDrawIdx>(i - 1), static_cast<ImDrawIdx>(i) });
+    }
+    for (size_t i0 = nb_segments - 1, i1 = 0; i1 < nb_segments; i0 = i1++)
+    {
+        const auto inner0 = static_cast<ImDrawIdx>(i0);
+        const auto inner1 = static_cast<ImDrawIdx>(i1);
+        const auto outer0 = static_cast<ImDrawIdx>(nb_segments + i0);
+        const auto outer1 = static_cast<ImDrawIdx>(nb_segments + i1);
+        m_marker_indices.insert(m_marker_indices.end(), { inner1, inner0, outer0, outer0, outer1, inner1 });
+    }
+}
+
+void DrawListBuilder::Bake(ImFontAtlas* atlas)
+{
+    // The disc covers its pixels by the part of them within radius + 0.5 of its center, with a
+    // pixel of margin so that the quad edges stay transparent.
+    const float radius = m_style.marker_radius;
+    const int size = static_cast<int>(std::ceil(2.f * radius)) + 2;
+    const int rect_index = atlas->AddCustomRectRegular(size, size);
+
+    atlas->ClearTexData();
+    unsigned char* alpha = nullptr;
+    int width = 0;
+    int height = 0;
+    atlas->GetTexDataAsAlpha8(&alpha, &width, &height);
+
+    const ImFontAtlasCustomRect* rect = atlas->GetCustomRectByIndex(rect_index);
+    const glm::vec2 center(0.5f * static_cast<float>(size));
+    for (int y = 0; y < size; ++y)
+    {
+        for (int x = 0; x < size; ++x)
+        {
+            const float distance = glm::length(glm::vec2(static_cast<float>(x) + 0.5f, static_cast<float>(y) + 0.5f) - center);
+            const float coverage = std::clamp(radius + 0.5f - distance, 0.f, 1.f);
+            alpha[(rect->Y + y) * width + rect->X + x] = static_cast<unsigned char>(std::lround(255.f * coverage));
+        }
+    }
+
+    // Backends upload either format, the RGBA one is converted from the alpha one.
+    unsigned char* rgba = nullptr;
+    atlas->GetTexDataAsRGBA32(&rgba, &width, &height);
+    atlas->CalcCustomRectUV(rect, &m_marker_uv_min, &m_marker_uv_max);
+    m_marker_half_size = 0.5f * static_cast<float>(size);
+
+    // Same conditions as ImGui's own strokes for the baked lines.
+    const ImGuiStyle& style = ImGui::GetStyle();
+    const int thickness = static_cast<int>(std::max(m_style.line_thickness, 1.f));
+    m_has_line_texture = style.AntiAliasedLines && style.AntiAliasedLinesUseTex && !(atlas->Flags & ImFontAtlasFlags_NoBakedLines)
+        && static_cast<float>(thickness) == m_style.line_thickness && thickness < IM_DRAWLIST_TEX_LINES_WIDTH_MAX;
+    m_line_uv = atlas->TexUvLines[std::min(thickness, IM_DRAWLIST_TEX_LINES_WIDTH_MAX)];
+    m_white_uv = atlas->TexUvWhitePixel;
+    m_is_baked = true;
+}
+
+void DrawListBuilder::Clear()
+{
+    m_vertices.clear();
+    m_indices.clear();
+    m_chunks.clear();
+}
+
+void DrawListBuilder::AddPolyline
+(
+    std::span<const glm::vec2> points,
+    bool draw_normals
+)
+{
+    if (!m_is_baked)
+    {
+        m_white_uv = ImGui::GetFontTexUvWhitePixel();
+    }
+
+    AddStroke(points, m_style.line_color);
+    for (const glm::vec2& point : points)
+    {
+        AddMarker(point);
+    }
+
+    if (draw_normals)
+    {
+        for (size_t n = 1; n + 1 < points.size(); n++)
+        {
+            // The tangent turned a quarter counterclockwise, (-tangent.y, tangent.x) normalized.
+            const glm::vec2 normal = SegmentNormal(points[n + 1], points[n - 1]);
+            const glm::vec2 segment[2] = { points[n], points[n] + normal * m_style.normal_length };
+            AddStroke(segment, m_style.normal_color);
+        }
+    }
+}
+
+void DrawListBuilder::Emit
+(
+    ImDrawList* draw_list,
+    const glm::vec2& origin
+) const
+{
+    if (m_chunks.empty())
+    {
+        return;
+    }
+
+    draw_list->VtxBuffer.reserve(draw_list->VtxBuffer.Size + static_cast<int>(m_vertices.size()));
+    draw_list->IdxBuffer.reserve(draw_list->IdxBuffer.Size + static_cast<int>(m_indices.size()));
+
+    for (const chunk& c : m_chunks)
+    {
+        // Starts a new draw command when the chunk does not fit the current one, given that
+        // the renderer supports vertex offsets as the OpenGL 3 backend does.
+        draw_list->PrimReserve(static_cast<int>(c.nb_indices), static_cast<int>(c.nb_vertices));
+        assert(sizeof(ImDrawIdx) > 2 || draw_list->_VtxCurrentIdx + c.nb_vertices <= max_chunk_vertices);
+
+        ImDrawVert* vertices = draw_list->_VtxWritePtr;
+        for (uint32_t i = 0; i < c.nb_vertices; ++i)
+        {
+            vertices[i] = m_vertices[c.first_vertex + i];
+            vertices[i].pos.x += origin.x;
+            vertices[i].pos.y += origin.y;
+        }
+
+        const unsigned int base = draw_list->_VtxCurrentIdx;
+        ImDrawIdx* indices = draw_list->_IdxWritePtr;
+        for (uint32_t i = 0; i < c.nb_indices; ++i)
+        {
+            indices[i] = static_cast<ImDrawIdx>(base + m_indices[c.first_index + i]);
+        }
+
+        draw_list->_VtxWritePtr += c.nb_vertices;
+        draw_list->_IdxWritePtr += c.nb_indices;
+        draw_list->_VtxCurrentIdx += c.nb_vertices;
+    }
+}
+
+size_t DrawListBuilder::GetNbVertices() const
+{
+    return m_vertices.size();
+}
+
+size_t DrawListBuilder::GetNbIndices() const
+{
+    return m_indices.size();
+}
+
+uint32_t DrawListBuilder::Reserve
+(
+    size_t nb_vertices,
+    size_t nb_indices
+)
+{
+    assert(nb_vertices <= max_chunk_vertices);
+    if (m_chunks.empty() || m_chunks.back().nb_vertices + nb_vertices > max_chunk_vertices)
+    {
+        m_chunks.push_back({ static_cast<uint32_t>(m_vertices.size()), 0, static_cast<uint32_t>(m_indices.size()), 0 });
+    }
+
+    chunk& c = m_chunks.back();
+    const uint32_t first = c.nb_vertices;
+    c.nb_vertices += static_cast<uint32_t>(nb_vertices);
+    c.nb_indices += static_cast<uint32_t>(nb_indices);
+    return first;
+}
+
+void DrawListBuilder::AddStroke
+(
+    std::span<const glm::vec2> points,
+    ImU32 color
+)
+{
+    if (points.size() < 2)
+    {
+        return;
+    }
+
+    // Same geometry as ImGui's anti-aliased thick lines. With the baked lines, 2 vertices per point
+    // whose texture holds the fringe ; otherwise 4 across the stroke : outer fringe, inner edge,
+    // inner edge, outer fringe. Strokes longer than a chunk are split on a shared point, with the
+    // normals of the whole stroke so that the pieces join.
+    const size_t vertices_per_point = m_has_line_texture ? 2 : 4;
+    const size_t indices_per_segment = m_has_line_texture ? 6 : 18;
+    const float half_inner = std::max(m_style.line_thickness - aa_size, 0.f) * 0.5f;
+    const float half_outer = m_has_line_texture ? m_style.line_thickness * 0.5f + 1.f : half_inner + aa_size;
+    const ImU32 transparent = color & ~IM_COL32_A_MASK;
+
+    const size_t max_piece_points = max_chunk_vertices / vertices_per_point;
+    for (size_t first = 0; first + 1 < points.size();)
+    {
+        const size_t last = std::min(first + max_piece_points, points.size()) - 1;
+        const size_t nb_points = last + 1 - first;
+        const uint32_t base = Reserve(vertices_per_point * nb_points, indices_per_segment * (nb_points - 1));
+
+        glm::vec2 previous = SegmentNormal(points[first > 0 ? first - 1 : 0], points[first > 0 ? first : 1]);
+        for (size_t i = first; i <= last; ++i)
+        {
+            const glm::vec2 next = i + 1 < points.size() ? SegmentNormal(points[i], points[i + 1]) : previous;
+            const glm::vec2 normal = MiterNormal(previous, next);
+            previous = next;
+
+            if (m_has_line_texture)
+            {
+                m_vertices.push_back(Vertex(points[i] + normal * half_outer, ImVec2(m_line_uv.x, m_line_uv.y), color));
+                m_vertices.push_back(Vertex(points[i] - normal * half_outer, ImVec2(m_line_uv.z, m_line_uv.w), color));
+            }
+            else
+            {
+                m_vertices.push_back(Vertex(points[i] + normal * half_outer, m_white_uv, transparent));
+                m_vertices.push_back(Vertex(points[i] + normal * half_inner, m_white_uv, color));
+                m_vertices.push_back(Vertex(points[i] - normal * half_inner, m_white_uv, color));
+                m_vertices.push_back(Vertex(points[i] - normal * half_outer, m_white_uv, transparent));
+            }
+        }
+
+        for (size_t i = 0; i + 1 < nb_points; ++i)
+        {
+            const auto a = static_cast<ImDrawIdx>(base + vertices_per_point * i);
+            const auto b = static_cast<ImDrawIdx>(a + vertices_per_point);
+            if (m_has_line_texture)
+            {
+                m_indices.insert(m_indices.end(), { b, a, static_cast<ImDrawIdx>(a + 1), static_cast<ImDrawIdx>(b + 1), static_cast<ImDrawIdx>(a + 1), b });
+                continue;
+            }
+            m_indices.insert(m_indices.end(),
+                {
+                    static_cast<ImDrawIdx>(b + 1), static_cast<ImDrawIdx>(a + 1), static_cast<ImDrawIdx>(a + 2),
+                    static_cast<ImDrawIdx>(a + 2), static_cast<ImDrawIdx>(b + 2), static_cast<ImDrawIdx>(b + 1),
+                    static_cast<ImDrawIdx>(b + 1), static_cast<ImDrawIdx>(a + 1), a,
+                    a, b, static_cast<ImDrawIdx>(b + 1),
+                    static_cast<ImDrawIdx>(b + 2), static_cast<ImDrawIdx>(a + 2), static_cast<ImDrawIdx>(a + 3),
+                    static_cast<ImDrawIdx>(a + 3), static_cast<ImDrawIdx>(b + 3), static_cast<ImDrawIdx>(b + 2)
+                });
+        }
+
+        first = last;
+    }
+}
+
+void DrawListBuilder::AddMarker(const glm::vec2& center)
+{
+    const ImU32 color = m_style.marker_color;
+    if (m_is_baked)
+    {
+        const uint32_t base = Reserve(4, 6);
+        const glm::vec2 min = center - m_marker_half_size;
+        const glm::vec2 max = center + m_marker_half_size;
+        m_vertices.push_back(Vertex(min, m_marker_uv_min, color));
+        m_vertices.push_back(Vertex(glm::vec2(max.x, min.y), ImVec2(m_marker_uv_max.x, m_marker_uv_min.y), color));
+        m_vertices.push_back(Vertex(max, m_marker_uv_max, color));
+        m_vertices.push_back(Vertex(glm::vec2(min.x, max.y), ImVec2(m_marker_uv_min.x, m_marker_uv_max.y), color));
+
+        const auto a = static_cast<ImDrawIdx>(base);
+        m_indices.insert(m_indices.end(), { a, static_cast<ImDrawIdx>(a + 1), static_cast<ImDrawIdx>(a + 2), a, static_cast<ImDrawIdx>(a + 2), static_cast<ImDrawIdx>(a + 3) });
+        return;
+    }
+
+    const size_t nb_segments = m_marker_offsets.size() / 2;
+    const uint32_t base = Reserve(m_marker_offsets.size(), m_marker_indices.size());
+    const ImU32 transparent = color & ~IM_COL32_A_MASK;
+    for (size_t i = 0; i < m_marker_offsets.size(); ++i)
+    {
+        m_vertices.push_back(Vertex(center + m_marker_offsets[i], m_white_uv, i < nb_segments ? color : transparent));
+    }
+    for (ImDrawIdx index : m_marker_indices)
+    {
+        m_indices.push_back(static_cast<ImDrawIdx>(base + index));
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "imgui.h"
+
+// Builds the tessellated splines into an ImDrawList : every polyline as one anti-aliased stroke,
+// its samples as copies of one marker. The geometry is kept in canvas coordinates, so that it can be
+// emitted again on the following frames while the scene does not change.
+class DrawListBuilder
+{
+public:
+    struct Style
+    {
+        ImU32 line_color = IM_COL32(255, 255, 0, 255);
+        float line_thickness = 2.f;
+        ImU32 marker_color = IM_COL32(255, 0, 0, 255);
+        float marker_radius = 3.f;
+        ImU32 normal_color = IM_COL32(0, 255, 0, 255);
+        float normal_length = 20.f;
+    };
+
+    DrawListBuilder();
+    explicit DrawListBuilder(const Style& style);
+
+    // Adds the marker disc to the font atlas and builds it. Strokes then use the atlas baked lines,
+    // 2 vertices per point, and markers are one textured quad ; both are polygons with an
+    // anti-aliasing fringe otherwise. Must be called before the atlas texture is uploaded.
+    void Bake(ImFontAtlas* atlas);
+
+    void Clear();
+
+    // Stroke through the points, a marker on each of them and optionally their normals.
+    void AddPolyline(std::span<const glm::vec2> points, bool draw_normals);
+
+    // Copies the geometry translated by origin, reserving the draw list buffers once for all of it.
+    void Emit(ImDrawList* draw_list, const glm::vec2& origin) const;
+
+    size_t GetNbVertices() const;
+    size_t GetNbIndices() const;
+
+private:
+    // Vertices a single draw command can address, indices are relative to their chunk.
+    struct chunk
+    {
+        uint32_t first_vertex = 0;
+        uint32_t nb_vertices = 0;
+        uint32_t first_index = 0;
+        uint32_t nb_indices = 0;
+    };
+
+    static constexpr size_t max_chunk_vertices = sizeof(ImDrawIdx) == 2 ? size_t(1) << 16 : size_t(UINT32_MAX);
+
+    // Room for the vertices of a primitive, starting a new chunk when they would not fit.
+    // Returns the chunk relative index of the first vertex.
+    uint32_t Reserve(size_t nb_vertices, size_t nb_indices);
+
+    void AddStroke(std::span<const glm::vec2> points, ImU32 color);
+    void AddMarker(const glm::vec2& center);
+
+    Style m_style;
+
+    bool m_is_baked = false;
+    bool m_has_line_texture = false;
+    ImVec4 m_line_uv;
+    ImVec2 m_white_uv;
+    float m_marker_half_size = 0.f;
+    ImVec2 m_marker_uv_min;
+    ImVec2 m_marker_uv_max;
+
+    // Polygon marker : inner ring then outer fringe, around the origin.
+    std::vector<glm::vec2> m_marker_offsets;
+    std::vector<ImDrawIdx> m_marker_indices;
+
+    std::vector<ImDrawVert> m_vertices;
+    std::vector<ImDrawIdx> m_indices;
+    std::vector<chunk> m_chunks;
+};
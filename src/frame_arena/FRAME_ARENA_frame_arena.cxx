@@ -0,0 +1,78 @@
+#include "../frame_arena/frame_arena.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+FrameArena::FrameArena(size_t capacity)
+    : m_block(std::make_unique_for_overwrite<std::byte[]>(capacity))
+    , m_capacity(capacity)
+{
+}
+
+void FrameArena::Reset()
+{
+    m_peak = std::max(m_peak, GetUsedBytes());
+    if (!m_overflow.empty())
+    {
+        m_capacity = std::max(2 * m_capacity, m_used + m_overflow_bytes);
+        m_block = std::make_unique_for_overwrite<std::byte[]>(m_capacity);
+        m_overflow.clear();
+        m_overflow_bytes = 0;
+    }
+    m_used = 0;
+}
+
+size_t FrameArena::GetUsedBytes() const
+{
+    return m_used + m_overflow_bytes;
+}
+
+size_t FrameArena::GetPeakBytes() const
+{
+    return m_peak;
+}
+
+size_t FrameArena::GetCapacity() const
+{
+    return m_capacity;
+}
+
+void* FrameArena::do_allocate
+(
+    size_t bytes,
+    size_t alignment
+)
+{
+    assert((alignment & (alignment - 1)) == 0);
+
+    const auto address = reinterpret_cast<uintptr_t>(m_block.get());
+    const size_t offset = ((address + m_used + alignment - 1) & ~(alignment - 1)) - address;
+    if (offset + bytes <= m_capacity)
+    {
+        m_used = offset + bytes;
+        return m_block.get() + offset;
+    }
+
+    // The padding makes room to align the allocation within its own block.
+    const size_t nb_bytes = bytes + alignment - 1;
+    std::byte* block = m_overflow.emplace_back(std::make_unique_for_overwrite<std::byte[]>(nb_bytes)).get();
+    m_overflow_bytes += nb_bytes;
+    void* ptr = block;
+    size_t space = nb_bytes;
+    return std::align(alignment, bytes, ptr, space);
+}
+
+void FrameArena::do_deallocate
+(
+    void*,
+    size_t,
+    size_t
+)
+{
+}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+// Memory of the temporaries of one frame. Allocations bump an offset in one block and are all
+// released at once by Reset, deallocating does nothing. A frame that outgrows the block takes the
+// rest from the heap, and the next Reset grows the block to hold all of it, so that frames alike
+// no longer allocate. Not thread safe, it belongs to the UI thread.
+class FrameArena : public std::pmr::memory_resource
+{
+public:
+    explicit FrameArena(size_t capacity = 1 << 20);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // Everything allocated since the last reset must be dead.
+    void Reset();
+
+    // Bytes allocated since the last reset, alignment padding included.
+    size_t GetUsedBytes() const;
+
+    // Most bytes used by one frame, as of the last reset.
+    size_t GetPeakBytes() const;
+    size_t GetCapacity() const;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    std::unique_ptr<std::byte[]> m_block;
+    size_t m_capacity;
+    size_t m_used = 0;
+    std::vector<std::unique_ptr<std::byte[]>> m_overflow;
+    size_t m_overflow_bytes = 0;
+    size_t m_peak = 0;
+};
@@ -0,0 +1,175 @@
+#include "../input_recorder/input_recorder.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+    struct file_header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t frame_size;
+        uint64_t nb_frames;
+        uint64_t nb_characters;
+    };
+
+    constexpr std::array<ImGuiKey, 4> modifier_keys = { ImGuiMod_Ctrl, ImGuiMod_Shift, ImGuiMod_Alt, ImGuiMod_Super };
+}
+
+void InputRecorder::Record()
+{
+    const ImGuiIO& io = ImGui::GetIO();
+
+    InputRecording::frame f{};
+    f.display_size = io.DisplaySize;
+    f.mouse_pos = io.MousePos;
+    f.mouse_wheel = io.MouseWheel;
+    f.mouse_wheel_h = io.MouseWheelH;
+    for (int button = 0; button < 5; ++button)
+    {
+        f.mouse_down |= io.MouseDown[button] ? static_cast<uint8_t>(1 << button) : 0;
+    }
+    const std::array<bool, 4> modifiers = { io.KeyCtrl, io.KeyShift, io.KeyAlt, io.KeySuper };
+    for (size_t i = 0; i < modifiers.size(); ++i)
+    {
+        f.modifiers |= modifiers[i] ? static_cast<uint8_t>(1 << i) : 0;
+    }
+    for (int key = 0; key < InputRecording::nb_keys; ++key)
+    {
+        if (ImGui::IsKeyDown(static_cast<ImGuiKey>(ImGuiKey_NamedKey_BEGIN + key)))
+        {
+            f.keys_down[key / 64] |= uint64_t(1) << (key % 64);
+        }
+    }
+    f.nb_characters = static_cast<uint16_t>(io.InputQueueCharacters.Size);
+    m_characters.insert(m_characters.end(), io.InputQueueCharacters.begin(), io.InputQueueCharacters.end());
+
+    m_frames.push_back(f);
+}
+
+size_t InputRecorder::GetNbFrames() const
+{
+    return m_frames.size();
+}
+
+bool InputRecorder::Save(const char* path) const
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+
+    file_header header{};
+    std::memcpy(header.magic, InputRecording::magic, sizeof(header.magic));
+    header.version = InputRecording::version;
+    header.frame_size = sizeof(InputRecording::frame);
+    header.nb_frames = m_frames.size();
+    header.nb_characters = m_characters.size();
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(m_frames.data()), static_cast<std::streamsize>(m_frames.size() * sizeof(InputRecording::frame)));
+    file.write(reinterpret_cast<const char*>(m_characters.data()), static_cast<std::streamsize>(m_characters.size() * sizeof(ImWchar)));
+    return static_cast<bool>(file.flush());
+}
+
+std::optional<InputReplay> InputReplay::Load(const char* path)
+{
+    std::ifstream file(path, std::ios::binary);
+    file_header header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+        return std::nullopt;
+    }
+    const bool is_valid = std::memcmp(header.magic, InputRecording::magic, sizeof(header.magic)) == 0
+        && header.version == InputRecording::version
+        && header.frame_size == sizeof(InputRecording::frame);
+    if (!is_valid)
+    {
+        return std::nullopt;
+    }
+
+    // The counts are checked against the bytes that follow the header before anything is allocated
+    // for them, a corrupted one would otherwise ask for any size.
+    const std::streamoff header_end = file.tellg();
+    file.seekg(0, std::ios::end);
+    const std::streamoff file_end = file.tellg();
+    file.seekg(header_end);
+    if (header_end < 0 || file_end < header_end)
+    {
+        return std::nullopt;
+    }
+    const auto nb_bytes = static_cast<uint64_t>(file_end - header_end);
+    const bool do_counts_fit = header.nb_frames <= nb_bytes / sizeof(InputRecording::frame)
+        && header.nb_characters <= (nb_bytes - header.nb_frames * sizeof(InputRecording::frame)) / sizeof(ImWchar);
+    if (!do_counts_fit)
+    {
+        return std::nullopt;
+    }
+
+    InputReplay replay;
+    replay.m_frames.resize(header.nb_frames);
+    replay.m_characters.resize(header.nb_characters);
+    file.read(reinterpret_cast<char*>(replay.m_frames.data()), static_cast<std::streamsize>(replay.m_frames.size() * sizeof(InputRecording::frame)));
+    file.read(reinterpret_cast<char*>(replay.m_characters.data()), static_cast<std::streamsize>(replay.m_characters.size() * sizeof(ImWchar)));
+    if (!file)
+    {
+        return std::nullopt;
+    }
+
+    // Characters are consumed in order, every frame has to find its own.
+    size_t nb_characters = 0;
+    for (const InputRecording::frame& f : replay.m_frames)
+    {
+        nb_characters += f.nb_characters;
+    }
+    if (nb_characters != replay.m_characters.size())
+    {
+        return std::nullopt;
+    }
+
+    return replay;
+}
+
+bool InputReplay::Apply(ImGuiIO& io, float delta_time)
+{
+    if (m_next_frame == m_frames.size())
+    {
+        return false;
+    }
+    const InputRecording::frame& f = m_frames[m_next_frame++];
+
+    io.DeltaTime = delta_time;
+    io.DisplaySize = f.display_size;
+    io.AddMousePosEvent(f.mouse_pos.x, f.mouse_pos.y);
+    for (int button = 0; button < 5; ++button)
+    {
+        io.AddMouseButtonEvent(button, (f.mouse_down >> button) & 1);
+    }
+    if (f.mouse_wheel != 0.f || f.mouse_wheel_h != 0.f)
+    {
+        io.AddMouseWheelEvent(f.mouse_wheel_h, f.mouse_wheel);
+    }
+
+    // Key events are filtered by ImGui when the state does not change.
+    for (size_t i = 0; i < modifier_keys.size(); ++i)
+    {
+        io.AddKeyEvent(modifier_keys[i], (f.modifiers >> i) & 1);
+    }
+    for (int key = 0; key < InputRecording::nb_keys; ++key)
+    {
+        io.AddKeyEvent(static_cast<ImGuiKey>(ImGuiKey_NamedKey_BEGIN + key), (f.keys_down[key / 64] >> (key % 64)) & 1);
+    }
+    for (uint16_t i = 0; i < f.nb_characters; ++i)
+    {
+        io.AddInputCharacter(m_characters[m_next_character++]);
+    }
+
+    return true;
+}
+
+size_t InputReplay::GetNbFrames() const
+{
+    return m_frames.size();
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "imgui.h"
+
+// ImGui input of a session, frame by frame, to replay editor interactions without a window.
+// Frames hold the input state ImGui saw after NewFrame : display size, mouse, keyboard keys,
+// modifiers and typed characters. Replaying them on the same scene and layout reproduces the session.
+namespace InputRecording
+{
+    constexpr char magic[8] = { 'S', 'P', 'L', 'I', 'N', 'P', 'U', 'T' };
+    constexpr uint32_t version = 1;
+
+    // Keyboard keys, without the gamepad, mouse and modifier ones.
+    constexpr int nb_keys = ImGuiKey_GamepadStart - ImGuiKey_NamedKey_BEGIN;
+    static_assert(nb_keys <= 128);
+
+    struct frame
+    {
+        ImVec2 display_size;
+        ImVec2 mouse_pos;
+        float mouse_wheel;
+        float mouse_wheel_h;
+        uint8_t mouse_down;         // Bit i for button i.
+        uint8_t modifiers;          // Ctrl, Shift, Alt, Super.
+        uint16_t nb_characters;     // Typed during the frame, following those of the previous frames.
+        uint32_t reserved;
+        std::array<uint64_t, 2> keys_down;
+    };
+    static_assert(sizeof(frame) == 48);
+};
+
+class InputRecorder
+{
+public:
+    // Captures the current frame, to call after ImGui::NewFrame.
+    void Record();
+
+    size_t GetNbFrames() const;
+
+    // Returns false when the file cannot be written.
+    bool Save(const char* path) const;
+
+private:
+    std::vector<InputRecording::frame> m_frames;
+    std::vector<ImWchar> m_characters;
+};
+
+class InputReplay
+{
+public:
+    // Empty when the file cannot be read or is not a recording of this version.
+    static std::optional<InputReplay> Load(const char* path);
+
+    // Queues the input of the next frame and sets the fixed time step, to call before ImGui::NewFrame.
+    // The event queue must not trickle, so that every change lands in its frame. Returns false
+    // once every frame was played.
+    bool Apply(ImGuiIO& io, float delta_time);
+
+    size_t GetNbFrames() const;
+
+private:
+    std::vector<InputRecording::frame> m_frames;
+    std::vector<ImWchar> m_characters;
+    size_t m_next_frame = 0;
+    size_t m_next_character = 0;
+};
@@ -7,110 +7,31 @@
 
 #include <math.h>
 #include <iostream>
-#include <format>
 #include <ranges>
 #include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
 
 #include "cubic_bezier_spline_2d/cubic_bezier_spline_2d.h"
 #include "cubic_hermite_spline_2d/cubic_hermite_spline_2d.h"
 #include "cubic_bspline_2d/cubic_bspline_2d.h"
+#include "bspline_fit/bspline_fit.h"
 #include "discretization/discretization.h"
-
-enum class spline_type : uint32_t
-{
-    BEZIER,
-    HERMITE,
-    BSPLINE
-};
-
-enum class draw_option : uint32_t
-{
-    NONE = 0,
-    CONTROL_POLYGON = 1 << 0,
-    NORMALS = 1 << 1,
-    BBOX = 1 << 2
-};
-
-inline draw_option operator|(draw_option a, draw_option b)
-{
-    return static_cast<draw_option>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
-}
-
-inline draw_option operator&(draw_option a, draw_option b)
-{
-    return static_cast<draw_option>(static_cast<uint32_t>(a) & static_cast<uint32_t>(b));
-}
-
-inline draw_option& operator|=(draw_option& a, draw_option b)
-{
-    a = a | b;
-    return a;
-}
-
-inline draw_option& operator&=(draw_option& a, draw_option b)
-{
-    a = a & b;
-    return a;
-}
-
-inline draw_option& operator^=(draw_option& a, draw_option b)
-{
-    a = static_cast<draw_option>(static_cast<uint32_t>(a) ^ static_cast<uint32_t>(b));
-    return a;
-}
-
-inline draw_option operator~(draw_option a)
-{
-    return static_cast<draw_option>(~static_cast<uint32_t>(a));
-}
-
-struct axis_aligned_bounding_box
-{
-    glm::vec2 min = { INFINITY, INFINITY };
-    glm::vec2 max = { -INFINITY, -INFINITY };
-    explicit axis_aligned_bounding_box(const std::vector < glm::vec2 >& points)
-    {
-        std::ranges::for_each(points, [&](const glm::vec2& point)
-            {
-                min = glm::min(min, point);
-                max = glm::max(max, point);
-            });
-    }
-};
-
-struct data
-{
-    std::vector < std::vector< glm::vec2 > > splines_points;
-    std::vector<spline_type> splines_type;
-    std::vector<glm::uvec3> splines_color;
-    std::vector<int32_t> splines_discretization;
-    std::vector<draw_option> splines_draw_options;
-    std::vector<axis_aligned_bounding_box> splines_bounding_boxs;
-
-    void add_spline
-    (
-        const std::vector<glm::vec2>& spline_points,
-        const spline_type spline_type,
-        const glm::uvec3 spline_color = glm::uvec3(255, 255, 255),
-        const int32_t spline_discretization = 100
-    )
-    {
-        splines_points.push_back(spline_points);
-        splines_type.push_back(spline_type);
-        splines_color.push_back(spline_color);
-        splines_discretization.push_back(spline_discretization);
-        splines_draw_options.push_back(draw_option::NONE);
-        splines_bounding_boxs.push_back(axis_aligned_bounding_box(spline_points));
-    }
-
-    void remove_spline(size_t index)
-    {
-        splines_points.erase(splines_points.begin() + index);
-        splines_type.erase(splines_type.begin() + index);
-        splines_color.erase(splines_color.begin() + index);
-        splines_discretization.erase(splines_discretization.begin() + index);
-    }
-};
+#include "scene/scene.h"
+#include "scene_file/scene_file.h"
+#include "scene_generator/scene_generator.h"
+#include "scene_history/scene_history.h"
+#include "svg_importer/svg_importer.h"
+#include "profiler/profiler.h"
+#include "draw_list_builder/draw_list_builder.h"
+#include "task_pool/task_pool.h"
+#include "input_recorder/input_recorder.h"
+#include "allocation_counter/allocation_counter.h"
+#include "frame_arena/frame_arena.h"
 
 static void init_glfw_and_imgui(GLFWwindow*& window)
 {
@@ -142,6 +63,7 @@ static void init_glfw_and_imgui(GLFWwindow*& window)
     glfwSwapInterval(1);
 
     IMGUI_CHECKVERSION();
+    ImGui::SetAllocatorFunctions(AllocationCounter::Malloc, AllocationCounter::Free);
     ImGui::CreateContext();
 
     ImGui_ImplGlfw_InitForOpenGL(window, true);
@@ -220,74 +142,112 @@ static void draw_grid(bool is_grid_drawn, const ImVec2& canvas_p0, const ImVec2&
     }
 }
 
-static void draw_discrete_points(const data& data, const glm::vec2& origin)
+// visible_rect is the canvas in curve coordinates. The geometry is built for half a canvas
+// around it, and emitted again as is while the scene does not change and the view stays inside.
+static void draw_discrete_points(data& data, TaskPool& task_pool, DrawListBuilder& builder, FrameArena& arena, const glm::vec2& origin, const BoundingBox2d& visible_rect)
 {
-    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    SPLINE_PROFILE_SCOPE("draw_discrete_points");
+
+    static uint64_t built_generation = UINT64_MAX;
+    static BoundingBox2d built_rect;
 
-    for (size_t i = 0; i < data.splines_points.size(); i++)
+    if (built_generation != data.generation || !built_rect.Contains(visible_rect))
     {
-        std::vector<glm::vec2> points;
-        const std::vector<glm::vec2>& control_points = data.splines_points[i];
-        const int32_t discretization = data.splines_discretization[i];
-        switch (data.splines_type[i])
-        {
-            using enum spline_type;
-        case BEZIER: { points = Discretization::Linear(CubicBezierSpline2d(control_points), discretization);  } break;
-        case HERMITE: { points = Discretization::Linear(CubicHermiteSpline2d(control_points), discretization); } break;
-        case BSPLINE: { points = Discretization::Linear(CubicBSpline2d(control_points), discretization);       } break;
-        default:                                                                                                 break;
-        }
+        const glm::vec2 margin = 0.5f * visible_rect.GetSize();
+        built_rect = BoundingBox2d(visible_rect.min - margin, visible_rect.max + margin);
+        built_generation = data.generation;
 
-        auto draw_normals = static_cast<bool>(data.splines_draw_options[i] & draw_option::NORMALS);
-        for (int n = 0; n < points.size() - 1; n++)
-        {
-            const glm::vec2 point = points[n] + origin;
-            const glm::vec2 next = points[n + 1] + origin;
+        // Normals stick out 20 pixels from the curve.
+        const BoundingBox2d cull_rect = built_rect.Inflated(20.f);
+
+        std::pmr::vector<uint32_t> visible_splines(&arena);
+        data.get_splines_bvh().Query(cull_rect, [&](uint32_t i) { visible_splines.push_back(i); });
+        std::sort(visible_splines.begin(), visible_splines.end());
 
-            draw_list->AddLine({ point.x, point.y }, { next.x, next.y }, IM_COL32(255, 255, 0, 255), 2.0f);
-            draw_list->AddCircleFilled(ImVec2(origin.x + points[n].x, origin.y + points[n].y), 3, IM_COL32(255, 0, 0, 255));
-            if (draw_normals && n > 0)
+        // Runs of visible segments are evaluated on the task pool, then built as one polyline each.
+        // Adaptive tessellations are built whole.
+        std::pmr::vector<tessellation_range> ranges(&arena);
+        for (uint32_t i : visible_splines)
+        {
+            if (static_cast<bool>(data.splines_draw_options[i] & draw_option::ADAPTIVE_DISCRETIZATION))
             {
-                glm::vec2 tangent = points[n + 1] - points[n - 1];
-                glm::vec2 normal(-tangent.y, tangent.x);
-                normal = glm::normalize(normal);
-                normal *= 20.;
-                draw_list->AddLine(ImVec2(origin.x + points[n].x, origin.y + points[n].y), ImVec2(origin.x + points[n].x + normal.x, origin.y + points[n].y + normal.y), IM_COL32(0, 255, 0, 255), 2.0f);
+                ranges.push_back({ i, 0, 0 });
+                continue;
             }
 
+            const std::vector<BoundingBox2d>& segment_bounds = data.splines_cache[i].segment_bounds;
+            for (size_t first = 0; first < segment_bounds.size(); first++)
+            {
+                if (!segment_bounds[first].Overlaps(cull_rect))
+                {
+                    continue;
+                }
+                size_t last = first;
+                while (last + 1 < segment_bounds.size() && segment_bounds[last + 1].Overlaps(cull_rect))
+                {
+                    last++;
+                }
+                ranges.push_back({ i, static_cast<uint32_t>(first), static_cast<uint32_t>(last) });
+                first = last;
+            }
         }
-        if (!points.empty())
+
+        data.tessellate(task_pool, ranges, &arena);
+
+        SPLINE_PROFILE_SCOPE("DrawListBuilder::AddPolyline");
+
+        builder.Clear();
+        for (const tessellation_range& range : ranges)
         {
-            draw_list->AddCircleFilled(ImVec2(origin.x + points.back().x, origin.y + points.back().y), 3, IM_COL32(255, 0, 0, 255));
+            auto draw_normals = static_cast<bool>(data.splines_draw_options[range.spline] & draw_option::NORMALS);
+            builder.AddPolyline(data.get_tessellation(range.spline, range.first_segment, range.last_segment), draw_normals);
         }
     }
+
+    builder.Emit(ImGui::GetWindowDrawList(), origin);
 }
 
-static void draw_control_points(const data& data, const glm::vec2& origin, const glm::vec2& mouse_pos_in_canvas, const float point_radius)
+static void draw_control_points(data& data, FrameArena& arena, const glm::vec2& origin, const BoundingBox2d& visible_rect, const glm::vec2& mouse_pos_in_canvas, const float point_radius)
 {
+    SPLINE_PROFILE_SCOPE("draw_control_points");
+
     ImDrawList* draw_list = ImGui::GetWindowDrawList();
 
-    for (size_t i = 0; i < data.splines_points.size(); i++)
+    const auto point_near_mouse = data.find_control_point(mouse_pos_in_canvas, point_radius);
+    const BoundingBox2d cull_rect = visible_rect.Inflated(point_radius);
+
+    // Drawn in scene order, as the curves.
+    std::pmr::vector<uint32_t> visible_splines(&arena);
+    data.get_splines_bvh().Query(cull_rect, [&](uint32_t i) { visible_splines.push_back(i); });
+    std::sort(visible_splines.begin(), visible_splines.end());
+
+    for (uint32_t i : visible_splines)
     {
-        const glm::vec2* previous_point = nullptr;
         auto draw_control_polygon = static_cast<bool>(data.splines_draw_options[i] & draw_option::CONTROL_POLYGON);
-        for (const auto& point : data.splines_points[i])
+        auto draw_bbox = static_cast<bool>(data.splines_draw_options[i] & draw_option::BBOX);
+
+        const std::span<const glm::vec2> points = data.get_points(i);
+        const glm::vec2* previous_point = nullptr;
+        for (size_t j = 0; j < points.size(); j++)
         {
+            const glm::vec2& point = points[j];
             ImVec2 screen_pos(origin.x + point.x, origin.y + point.y);
 
-            if (draw_control_polygon && previous_point)
+            if (draw_control_polygon && previous_point && BoundingBox2d(glm::min(*previous_point, point), glm::max(*previous_point, point)).Overlaps(cull_rect))
             {
                 ImVec2 prev_screen_pos(origin.x + previous_point->x, origin.y + previous_point->y);
                 draw_list->AddLine(prev_screen_pos, screen_pos, IM_COL32(255, 255, 255, 255), 2.0f);
             }
+            previous_point = &point;
 
-            glm::vec2 mouse_to_point = glm::vec2(mouse_pos_in_canvas.x, mouse_pos_in_canvas.y) - point;
-            ImU32 color = glm::length(mouse_to_point) < point_radius ? IM_COL32(0, 255, 0, 255) : IM_COL32(0, 0, 255, 255);
+            if (!cull_rect.Contains(point))
+            {
+                continue;
+            }
+            const bool is_near_mouse = point_near_mouse && point_near_mouse->spline == i && point_near_mouse->point == j;
+            ImU32 color = is_near_mouse ? IM_COL32(0, 255, 0, 255) : IM_COL32(0, 0, 255, 255);
             draw_list->AddCircleFilled(screen_pos, point_radius, color);
-
-            previous_point = &point;
         }
-        auto draw_bbox = static_cast<bool>(data.splines_draw_options[i] & draw_option::BBOX);
         if (draw_bbox)
         {
             const glm::vec2& min = data.splines_bounding_boxs[i].min;
@@ -297,6 +257,55 @@ static void draw_control_points(const data& data, const glm::vec2& origin, const
     }
 }
 
+static void draw_curve_hover(data& data, const bool is_canvas_hovered, const glm::vec2& origin, const glm::vec2& mouse_pos_in_canvas, const float hover_distance)
+{
+    SPLINE_PROFILE_SCOPE("draw_curve_hover");
+
+    if (!is_canvas_hovered)
+    {
+        return;
+    }
+
+    auto closest = data.find_closest_curve_point(mouse_pos_in_canvas, hover_distance);
+    if (!closest)
+    {
+        return;
+    }
+
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    draw_list->AddCircle(ImVec2(origin.x + closest->point.x, origin.y + closest->point.y), 6.f, IM_COL32(255, 128, 0, 255), 0, 2.f);
+    ImGui::SetTooltip("Spline %u, t = %.4f", closest->spline, closest->t);
+}
+
+// Crossings between the splines, searched again only after the scene geometry changed.
+static void draw_intersections(data& data, const bool show_intersections, const glm::vec2& origin, const BoundingBox2d& visible_rect)
+{
+    SPLINE_PROFILE_SCOPE("draw_intersections");
+
+    static std::vector<CurveIntersection::Intersection> intersections;
+    static uint64_t intersections_generation = UINT64_MAX;
+
+    if (!show_intersections)
+    {
+        return;
+    }
+
+    if (intersections_generation != data.generation)
+    {
+        intersections = data.find_intersections(0.01f);
+        intersections_generation = data.generation;
+    }
+
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    for (const auto& intersection : intersections)
+    {
+        if (visible_rect.Contains(intersection.point))
+        {
+            draw_list->AddCircle(ImVec2(origin.x + intersection.point.x, origin.y + intersection.point.y), 4.f, IM_COL32(255, 64, 64, 255));
+        }
+    }
+}
+
 static void pan(bool is_active, bool is_context_menu_drawn, glm::vec2& scrolling)
 {
     const ImGuiIO& io = ImGui::GetIO(); (void)io;
@@ -325,53 +334,39 @@ static void add_line(const bool is_canvas_hovered, bool& adding_line, const ImVe
     }
 }
 
-static void move_point(data& data, const bool is_canvas_hovered, int& selected_curve, int& selected_point, const glm::vec2& mouse_pos_in_canvas, const float point_radius)
+static void move_point(data& data, SceneHistory& history, const bool is_canvas_hovered, int& selected_curve, int& selected_point, const glm::vec2& mouse_pos_in_canvas, const float point_radius)
 {
+    SPLINE_PROFILE_SCOPE("move_point");
+
     if (is_canvas_hovered && ImGui::IsMouseClicked(ImGuiMouseButton_Left))
     {
-        int point_near_mouse_id = -1;
-        auto point_is_near_mouse = [&](const glm::vec2& point)
-            {
-                glm::vec2 mouse_to_point = glm::vec2(mouse_pos_in_canvas.x, mouse_pos_in_canvas.y) - point;
-                return glm::length(mouse_to_point) < point_radius;
-            };
-
-        for (size_t i = 0; i < data.splines_points.size() && point_near_mouse_id == -1; i++)
+        if (auto point_near_mouse = data.find_control_point(mouse_pos_in_canvas, point_radius))
         {
-            const auto& control_points = data.splines_points[i];
-            if (auto it = std::ranges::find_if(control_points, point_is_near_mouse); it != control_points.end())
-            {
-                point_near_mouse_id = static_cast<int>(std::distance(control_points.begin(), it));
-            }
-
-            if (point_near_mouse_id != -1)
-            {
-                selected_curve = static_cast<int>(i);
-                selected_point = point_near_mouse_id;
-            }
+            selected_curve = static_cast<int>(point_near_mouse->spline);
+            selected_point = static_cast<int>(point_near_mouse->point);
         }
-
     }
 
     if (selected_point != -1 && selected_curve != -1)
     {
-        data.splines_points[selected_curve][selected_point] = { mouse_pos_in_canvas.x, mouse_pos_in_canvas.y };
-        if
-            (
-                data.splines_type[selected_curve] == spline_type::BEZIER
-                && selected_point % 3 == 0
-                && selected_point != 0
-                && selected_point != data.splines_points[selected_curve].size() - 2
-                )
+        if (data.get_points(selected_curve)[selected_point] != mouse_pos_in_canvas)
         {
-            data.splines_points[selected_curve][selected_point + 1] = { mouse_pos_in_canvas.x, mouse_pos_in_canvas.y };
+            data.move_control_point(selected_curve, selected_point, mouse_pos_in_canvas);
+            history.MarkChanged(selected_curve);
+            if
+                (
+                    data.splines_type[selected_curve] == spline_type::BEZIER
+                    && selected_point % 3 == 0
+                    && selected_point != 0
+                    && selected_point != data.get_points(selected_curve).size() - 2
+                    )
+            {
+                data.move_control_point(selected_curve, selected_point + 1, mouse_pos_in_canvas);
+            }
         }
 
-        axis_aligned_bounding_box updated_bbox(data.splines_points[selected_curve]);
-        data.splines_bounding_boxs[selected_curve] = updated_bbox;
-
 
-        draw_point_info(data.splines_points[selected_curve][selected_point]);
+        draw_point_info(data.get_points(selected_curve)[selected_point]);
         if (!ImGui::IsMouseDown(ImGuiMouseButton_Left))
         {
             selected_curve = -1;
@@ -380,7 +375,7 @@ static void move_point(data& data, const bool is_canvas_hovered, int& selected_c
     }
 }
 
-static void SplinePropertiesTab(data& data, const size_t selected)
+static void SplinePropertiesTab(data& data, SceneHistory& history, const size_t selected)
 {
     if (ImGui::BeginTabItem("Properties"))
     {
@@ -405,23 +400,24 @@ static void SplinePropertiesTab(data& data, const size_t selected)
             ImGui::TableNextColumn();
             ImGui::Text("Y");
 
-            for (int i = 0; i < data.splines_points[selected].size(); i++)
+            const std::span<glm::vec2> points = data.get_points(selected);
+            for (int i = 0; i < points.size(); i++)
             {
                 ImGui::TableNextColumn();
-                glm::vec2& point = data.splines_points[selected][i];
+                glm::vec2& point = points[i];
                 ImGui::Text("%d :", i);
 
                 ImGui::TableNextColumn();
                 ImGui::PushID(2 * i);
                 ImGui::PushItemWidth(-FLT_MIN);
-                ImGui::DragFloat(" ", &point.x, 1.f, -1000.0f, 1000.0f);
+                if (ImGui::DragFloat(" ", &point.x, 1.f, -1000.0f, 1000.0f)) { data.invalidate_spline(selected); history.MarkChanged(selected); }
                 ImGui::PopItemWidth();
                 ImGui::PopID();
 
                 ImGui::TableNextColumn();
                 ImGui::PushID(2 * i + 1);
                 ImGui::PushItemWidth(-FLT_MIN);
-                ImGui::DragFloat(" ", &point.y, 1.f, -1000.0f, 1000.0f);
+                if (ImGui::DragFloat(" ", &point.y, 1.f, -1000.0f, 1000.0f)) { data.invalidate_spline(selected); history.MarkChanged(selected); }
                 ImGui::PopItemWidth();
                 ImGui::PopID();
             }
@@ -430,45 +426,277 @@ static void SplinePropertiesTab(data& data, const size_t selected)
         ImGui::EndChild();
         ImGui::PopStyleVar();
 
-        ImGui::SliderInt("Discretization", &data.splines_discretization[selected], 2, 200);
+        bool adaptive = static_cast<uint32_t>(data.splines_draw_options[selected] & draw_option::ADAPTIVE_DISCRETIZATION);
+        if (ImGui::Checkbox("Adaptive discretization", &adaptive))
+        {
+            data.splines_draw_options[selected] ^= draw_option::ADAPTIVE_DISCRETIZATION;
+            data.invalidate_spline(selected);
+            history.MarkChanged(selected);
+        }
+
+        ImGui::BeginDisabled(adaptive);
+        if (ImGui::SliderInt("Discretization", &data.splines_discretization[selected], min_discretization, max_discretization)) { data.invalidate_spline(selected); history.MarkChanged(selected); }
+        ImGui::EndDisabled();
 
         bool draw_control_polygon = static_cast<uint32_t>(data.splines_draw_options[selected] & draw_option::CONTROL_POLYGON);
-        if (ImGui::Checkbox("Draw control polygon", &draw_control_polygon)) { data.splines_draw_options[selected] ^= draw_option::CONTROL_POLYGON; }
+        if (ImGui::Checkbox("Draw control polygon", &draw_control_polygon)) { data.splines_draw_options[selected] ^= draw_option::CONTROL_POLYGON; history.MarkChanged(selected); }
 
         bool draw_normals = static_cast<uint32_t>(data.splines_draw_options[selected] & draw_option::NORMALS);
-        if (ImGui::Checkbox("Draw normals", &draw_normals)) { data.splines_draw_options[selected] ^= draw_option::NORMALS; }
+        if (ImGui::Checkbox("Draw normals", &draw_normals))
+        {
+            data.splines_draw_options[selected] ^= draw_option::NORMALS;
+            data.invalidate_spline(selected);
+            history.MarkChanged(selected);
+        }
 
         ImGui::Text("Bounding box min : %f, %f", data.splines_bounding_boxs[selected].min.x, data.splines_bounding_boxs[selected].min.y);
         ImGui::Text("Bounding box max : %f, %f", data.splines_bounding_boxs[selected].max.x, data.splines_bounding_boxs[selected].max.y);
 
         bool draw_bbox = static_cast<uint32_t>(data.splines_draw_options[selected] & draw_option::BBOX);
-        if (ImGui::Checkbox("Draw bounding box", &draw_bbox)) { data.splines_draw_options[selected] ^= draw_option::BBOX; }
+        if (ImGui::Checkbox("Draw bounding box", &draw_bbox)) { data.splines_draw_options[selected] ^= draw_option::BBOX; history.MarkChanged(selected); }
 
         ImGui::EndTabItem();
     }
 }
 
-static void GeneralSettings()
+#ifdef SPLINE_ENABLE_PROFILER
+static void ProfilerOverlay()
 {
+    static std::vector<Profiler::event> events;
+    static bool paused = false;
+
+    if (!ImGui::CollapsingHeader("Profiler"))
+    {
+        return;
+    }
+
+    ImGui::Checkbox("Pause", &paused);
+    ImGui::SameLine();
+    if (ImGui::Button("Export Chrome trace"))
+    {
+        std::ofstream file("spline_trace.json");
+        Profiler::WriteChromeTrace(file);
+    }
+
+    // The current frame is still being recorded, show the previous one.
+    const uint64_t frame = Profiler::GetFrameIndex();
+    if (!paused && frame > 0)
+    {
+        Profiler::GetEvents().CollectFrame(frame - 1, events);
+    }
+    if (events.empty())
+    {
+        return;
+    }
+
+    uint64_t frame_begin = UINT64_MAX;
+    uint64_t frame_end = 0;
+    uint32_t max_depth = 0;
+    for (const auto& e : events)
+    {
+        frame_begin = std::min(frame_begin, e.begin_ns);
+        frame_end = std::max(frame_end, e.end_ns);
+        max_depth = std::max(max_depth, e.depth);
+    }
+    const auto frame_ns = static_cast<float>(std::max<uint64_t>(frame_end - frame_begin, 1));
+    ImGui::Text("Frame %.3f ms", frame_ns * 1e-6f);
+
+    // Flame graph : one row per nesting depth, widths proportional to the durations.
+    const float row_height = ImGui::GetTextLineHeightWithSpacing();
+    const float width = ImGui::GetContentRegionAvail().x;
+    const ImVec2 p0 = ImGui::GetCursorScreenPos();
+    ImGui::Dummy(ImVec2(width, row_height * static_cast<float>(max_depth + 1)));
+
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    for (const auto& e : events)
+    {
+        const ImVec2 min(p0.x + width * static_cast<float>(e.begin_ns - frame_begin) / frame_ns, p0.y + row_height * static_cast<float>(e.depth));
+        const ImVec2 max(p0.x + width * static_cast<float>(e.end_ns - frame_begin) / frame_ns, min.y + row_height - 1.f);
+        const auto hash = static_cast<uint32_t>(std::hash<const char*>()(e.name));
+        draw_list->AddRectFilled(min, max, IM_COL32(64 + hash % 128, 64 + (hash >> 8) % 128, 64 + (hash >> 16) % 128, 255));
+        draw_list->PushClipRect(min, max, true);
+        draw_list->AddText(ImVec2(min.x + 2.f, min.y), IM_COL32(255, 255, 255, 255), e.name);
+        draw_list->PopClipRect();
+        if (ImGui::IsMouseHoveringRect(min, max))
+        {
+            ImGui::SetTooltip("%s\n%.3f ms", e.name, static_cast<float>(e.end_ns - e.begin_ns) * 1e-6f);
+        }
+    }
+
+    // Per stage bars : total time of each scope name over the frame.
+    std::vector<std::pair<const char*, uint64_t>> stages;
+    for (const auto& e : events)
+    {
+        auto it = std::ranges::find(stages, e.name, &std::pair<const char*, uint64_t>::first);
+        if (it == stages.end())
+        {
+            stages.emplace_back(e.name, 0);
+            it = std::prev(stages.end());
+        }
+        it->second += e.end_ns - e.begin_ns;
+    }
+    for (const auto& [name, ns] : stages)
+    {
+        const float ms = static_cast<float>(ns) * 1e-6f;
+        char overlay[32];
+        snprintf(overlay, sizeof(overlay), "%.3f ms", ms);
+        ImGui::ProgressBar(static_cast<float>(ns) / frame_ns, ImVec2(width * 0.5f, 0.f), overlay);
+        ImGui::SameLine();
+        ImGui::TextUnformatted(name);
+    }
+}
+#endif
+
+static void GeneralSettings(data& data, SceneHistory& history)
+{
+    static char scene_path[256] = "scene.spl";
+    static const char* scene_file_status = "";
+
     ImGui::BeginChild("top pane", ImVec2(0, 0), ImGuiChildFlags_Borders | ImGuiChildFlags_ResizeY);
     ImGui::Text("General settings");
+
+    ImGui::InputText("Scene file", scene_path, sizeof(scene_path));
+    if (ImGui::Button("Save"))
+    {
+        scene_file_status = SceneFile::Write(scene_path, data) ? "Saved" : "Cannot write the file";
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Load"))
+    {
+        if (auto scene = MappedScene::Open(scene_path))
+        {
+            data.clear();
+            scene->CopyTo(data);
+            history.Reset(data);
+            scene_file_status = "Loaded";
+        }
+        else
+        {
+            scene_file_status = "Not a scene file of this version";
+        }
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Import SVG"))
+    {
+        // The paths are added to the current scene, one Bezier spline per subpath.
+        const size_t first_index = data.get_nb_splines();
+        const auto statistics = SvgImporter::ImportFile(scene_path, data);
+        history.CommitAddedSplines(data, first_index);
+        scene_file_status = !statistics ? "Cannot read the file" : statistics->nb_errors > 0 ? "Imported, some path data was invalid" : "Imported";
+    }
+    ImGui::SameLine();
+    ImGui::TextUnformatted(scene_file_status);
+
+    ImGui::BeginDisabled(!history.CanUndo());
+    if (ImGui::Button("Undo")) { history.Undo(data); }
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    ImGui::BeginDisabled(!history.CanRedo());
+    if (ImGui::Button("Redo")) { history.Redo(data); }
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    ImGui::Text("History : %zu entries, %.1f KiB", history.GetNbEntries(), static_cast<float>(history.GetMemoryUsage()) / 1024.f);
+
+    if (ImGui::SliderFloat("Adaptive tolerance (px)", &data.discretization_tolerance, 0.05f, 5.f, "%.2f", ImGuiSliderFlags_Logarithmic))
+    {
+        data.invalidate_adaptive_splines();
+    }
+    if (data.get_nb_splines() > 0)
+    {
+        const BoundingBox2d bounds = data.get_splines_bvh().GetBounds();
+        ImGui::Text("Scene bounds : (%.1f, %.1f) - (%.1f, %.1f)", bounds.min.x, bounds.min.y, bounds.max.x, bounds.max.y);
+    }
+#ifdef SPLINE_ENABLE_PROFILER
+    ProfilerOverlay();
+#endif
     ImGui::EndChild();
 }
 
-static void SplineList(const data& data, size_t& selected)
+static void SplineList(const data& data, spline_handle& selected)
 {
     ImGui::BeginChild("left pane", ImVec2(150, 0), ImGuiChildFlags_Borders | ImGuiChildFlags_ResizeX);
-    for (int i = 0; i < data.splines_points.size(); i++)
+    for (int i = 0; i < data.get_nb_splines(); i++)
     {
-        if (ImGui::Selectable(std::format("Spline {}", i).c_str(), selected == i))
+        char label[32];
+        snprintf(label, sizeof(label), "Spline %d", i);
+        const spline_handle handle = data.get_handle(i);
+        if (ImGui::Selectable(label, handle == selected))
         {
-            selected = i;
+            selected = handle;
         }
     }
     ImGui::EndChild();
 }
 
-static void SplineProperties(data& data, size_t& selected)
+// Exact conversions only : B-spline and Hermite splines to Bezier. The converted spline is added
+// next to the original, which is left unchanged.
+static void SplineAsOtherTypeTab(data& data, SceneHistory& history, const size_t selected)
+{
+    const std::span<const glm::vec2> points = data.get_points(selected);
+    std::optional<CubicBezierSpline2d> bezier_spline;
+    switch (data.splines_type[selected])
+    {
+        using enum spline_type;
+    case HERMITE: { if (points.size() > 3) { bezier_spline = CubicBezierSpline2d::FromCubicHermiteSpline2d(CubicHermiteSpline2d(points)); } } break;
+    case BSPLINE: { if (points.size() > 3) { bezier_spline = CubicBezierSpline2d::FromCubicBSpline2d(CubicBSpline2d(points));             } } break;
+    default:                                                                                                                                    break;
+    }
+
+    if (!bezier_spline)
+    {
+        ImGui::TextUnformatted("No exact conversion from this type");
+        return;
+    }
+
+    const std::vector<glm::vec2> bezier_points = bezier_spline->GetControlPoints();
+    ImGui::Text("Bezier : %zu curves, %zu control points", bezier_spline->m_curves.size(), bezier_points.size());
+    if (ImGui::Button("Add as Bezier"))
+    {
+        const size_t first_index = data.get_nb_splines();
+        data.add_spline(bezier_points, spline_type::BEZIER, data.splines_color[selected], data.splines_discretization[selected]);
+        history.CommitAddedSplines(data, first_index);
+    }
+}
+
+// Fits a B-spline to the tessellation of the spline, as it would to a measured trace.
+static void SplineFitTab(data& data, SceneHistory& history, const size_t selected)
+{
+    static int parameterization = static_cast<int>(BSplineFit::Parameterization::CENTRIPETAL);
+    static int nb_ctrl_pts = 16;
+
+    const std::vector<glm::vec2>& samples = data.get_tessellation(selected);
+    ImGui::Text("%zu tessellated points", samples.size());
+    ImGui::Combo("Parameterization", &parameterization, "Uniform\0Chord length\0Centripetal\0");
+    ImGui::SliderInt("Control points", &nb_ctrl_pts, 4, 256);
+
+    const auto fit_parameterization = static_cast<BSplineFit::Parameterization>(parameterization);
+    const size_t first_index = data.get_nb_splines();
+    if (ImGui::Button("Add least squares BSpline"))
+    {
+        const std::optional<std::vector<glm::vec2>> ctrl_pts = BSplineFit::Approximate(samples, nb_ctrl_pts, fit_parameterization);
+        if (ctrl_pts)
+        {
+            data.add_spline(*ctrl_pts, spline_type::BSPLINE, data.splines_color[selected], data.splines_discretization[selected]);
+        }
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Add interpolating Bezier"))
+    {
+        const std::optional<CubicBSpline2d> spline = BSplineFit::Interpolate(samples, fit_parameterization);
+        if (spline)
+        {
+            const std::vector<glm::vec2> bezier_points = CubicBezierSpline2d::FromCubicBSpline2d(*spline).GetControlPoints();
+            data.add_spline(bezier_points, spline_type::BEZIER, data.splines_color[selected], data.splines_discretization[selected]);
+        }
+    }
+
+    if (data.get_nb_splines() > first_index)
+    {
+        history.CommitAddedSplines(data, first_index);
+    }
+}
+
+static void SplineProperties(data& data, SceneHistory& history, const size_t selected)
 {
     ImGui::BeginGroup();
     ImGui::BeginChild("item view", ImVec2(0, -ImGui::GetFrameHeightWithSpacing())); // Leave room for 1 line below us
@@ -487,7 +715,7 @@ static void SplineProperties(data& data, size_t& selected)
     ImGui::Separator();
     if (ImGui::BeginTabBar("Tabs", ImGuiTabBarFlags_None))
     {
-        SplinePropertiesTab(data, selected);
+        SplinePropertiesTab(data, history, selected);
 
         if (ImGui::BeginTabItem("Derivatives"))
         {
@@ -498,7 +726,13 @@ static void SplineProperties(data& data, size_t& selected)
 
         if (ImGui::BeginTabItem("As Other Type"))
         {
-            ImGui::Text("TODO");
+            SplineAsOtherTypeTab(data, history, selected);
+            ImGui::EndTabItem();
+        }
+
+        if (ImGui::BeginTabItem("Fit"))
+        {
+            SplineFitTab(data, history, selected);
             ImGui::EndTabItem();
         }
         ImGui::EndTabBar();
@@ -508,114 +742,329 @@ static void SplineProperties(data& data, size_t& selected)
     if (ImGui::Button("Delete"))
     {
         data.remove_spline(selected);
-        selected = 0;
+        history.CommitRemovedSpline(data, selected);
     }
     ImGui::EndGroup();
 }
 
-static void ShowPropertiesWindow(data& data)
+static void ShowPropertiesWindow(data& data, SceneHistory& history)
 {
+    SPLINE_PROFILE_SCOPE("ShowPropertiesWindow");
+
     ImGui::SetNextWindowSize(ImVec2(500, 440), ImGuiCond_FirstUseEver);
     if (ImGui::Begin("Settings", nullptr, ImGuiWindowFlags_NoCollapse))
     {
-        static size_t selected = 0;
+        static spline_handle selected;
 
         // Top
-        GeneralSettings();
+        GeneralSettings(data, history);
+
+        // Deleting, undoing or loading a scene may have removed the selected spline.
+        if (data.get_nb_splines() > 0 && !data.find_spline(selected))
+        {
+            selected = data.get_handle(0);
+        }
 
         // Left
         SplineList(data, selected);
         ImGui::SameLine();
 
-        if (data.splines_points.empty())
+        if (data.get_nb_splines() == 0)
         {
             ImGui::End();
             return;
         }
 
         // Right
-        SplineProperties(data, selected);
+        SplineProperties(data, history, *data.find_spline(selected));
     }
     ImGui::End();
 }
 
-int main()
+static void ShowViewportWindow(data& data, SceneHistory& history, TaskPool& task_pool, DrawListBuilder& discrete_points_builder, FrameArena& arena)
 {
-    GLFWwindow* window = nullptr;
-
-    init_glfw_and_imgui(window);
-
-    const ImGuiIO& io = ImGui::GetIO(); (void)io;
+    const ImGuiIO& io = ImGui::GetIO();
 
     static bool show_window = false;
     static bool opt_enable_grid = true;
     static bool opt_enable_context_menu = true;
+    static bool opt_show_intersections = false;
     static float point_radius = 5.;
 
     static glm::vec2 scrolling(0.0f, 0.0f);
     static int selected_curve = -1;
     static int selected_point = -1;
 
-    data data;
-    std::vector<glm::vec2> bezier_control_points = { {0, 0}, {0, 100}, {100, 100}, {100, 0}, {200, 0}, {200, 100}, {200, 200}, {300, 0} };
-    std::vector<glm::vec2> bspline_control_points = { {0, 0}, {0, 100}, {100, 100}, {100, 0}, {200, 0}, {200, 100}, {200, 200}, {300, 0} };
-    data.add_spline(bezier_control_points, spline_type::BEZIER);
-    data.add_spline(bspline_control_points, spline_type::BSPLINE);
+    ImGui::Begin("Viewport", nullptr, ImGuiWindowFlags_NoCollapse);
 
-    while (!glfwWindowShouldClose(window))
+    ImGui::Checkbox("Enable grid", &opt_enable_grid); ImGui::SameLine();
+    ImGui::Checkbox("Enable context menu", &opt_enable_context_menu); ImGui::SameLine();
+    ImGui::Checkbox("Show demo window", &show_window); ImGui::SameLine();
+    ImGui::Checkbox("Show intersections", &opt_show_intersections);
+    ImGui::Text("Application average %.1f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
+
+    // Counted from one frame to the next, rendering included.
+    static uint64_t nb_allocations = 0;
+    const uint64_t nb_frame_allocations = AllocationCounter::GetNbAllocations() - nb_allocations;
+    nb_allocations += nb_frame_allocations;
+    ImGui::Text("Heap allocations %llu/frame, frame arena peak %.1f / %.1f KiB", static_cast<unsigned long long>(nb_frame_allocations), static_cast<float>(arena.GetPeakBytes()) / 1024.f, static_cast<float>(arena.GetCapacity()) / 1024.f);
+
+    ImGui::Text("Mouse Left: drag to add lines,\nMouse Right: drag to scroll, click for context menu.");
+    ImGui::SliderFloat("Point size", &point_radius, 1., 20.);
+
+    ImVec2 canvas_sz = ImGui::GetContentRegionAvail();
+    if (canvas_sz.x < 50.0f) canvas_sz.x = 50.0f;
+    if (canvas_sz.y < 50.0f) canvas_sz.y = 50.0f;
+    ImVec2 canvas_p0 = ImGui::GetCursorScreenPos();
+    ImVec2 canvas_p1(canvas_p0.x + canvas_sz.x, canvas_p0.y + canvas_sz.y);
+
+    // This will catch our interactions
+    ImGui::InvisibleButton("canvas", canvas_sz, ImGuiButtonFlags_MouseButtonLeft | ImGuiButtonFlags_MouseButtonRight);
+    const bool is_canvas_hovered = ImGui::IsItemHovered();
+    const bool is_active = ImGui::IsItemActive();
+    const glm::vec2 origin(canvas_p0.x + scrolling.x, canvas_p0.y + scrolling.y);
+    const glm::vec2 mouse_pos_in_canvas(io.MousePos.x - origin.x, io.MousePos.y - origin.y);
+    const BoundingBox2d visible_rect(-scrolling, glm::vec2(canvas_sz.x, canvas_sz.y) - scrolling);
+
+    draw_border(canvas_p0, canvas_p1);
+
+    move_point(data, history, is_canvas_hovered, selected_curve, selected_point, mouse_pos_in_canvas, point_radius);
+
+    pan(is_active, opt_enable_context_menu, scrolling);
+
+    //draw_context_menu(opt_enable_context_menu, adding_line, points);
+
+    draw_grid(opt_enable_grid, canvas_p0, canvas_sz, scrolling);
+
+    draw_discrete_points(data, task_pool, discrete_points_builder, arena, origin, visible_rect);
+
+    draw_control_points(data, arena, origin, visible_rect, mouse_pos_in_canvas, point_radius);
+
+    draw_intersections(data, opt_show_intersections, origin, visible_rect);
+
+    draw_curve_hover(data, is_canvas_hovered && selected_point == -1, origin, mouse_pos_in_canvas, 2.f * point_radius);
+
+    if (show_window) { ImGui::ShowDemoWindow(&show_window); }
+
+    ShowPropertiesWindow(data, history);
+
+    // Edits are committed once no widget or drag is using them anymore, one entry per drag.
+    if (!ImGui::IsAnyItemActive() && !ImGui::IsMouseDown(ImGuiMouseButton_Left))
     {
-        // Data
-        CubicBSpline2d bezier_spline(bezier_control_points);
+        if (ImGui::IsKeyChordPressed(ImGuiMod_Ctrl | ImGuiKey_Z)) { history.Undo(data); }
+        if (ImGui::IsKeyChordPressed(ImGuiMod_Ctrl | ImGuiKey_Y) || ImGui::IsKeyChordPressed(ImGuiMod_Ctrl | ImGuiMod_Shift | ImGuiKey_Z)) { history.Redo(data); }
+        history.Commit(data);
+    }
 
-        // GUI
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
-        ImGui::NewFrame();
+    ImGui::GetWindowDrawList()->PopClipRect();
+    ImGui::End();
+}
+
+struct options
+{
+    const char* scene_path = nullptr;
+    size_t nb_random_splines = 0;
+    const char* record_path = nullptr;
+    const char* replay_path = nullptr;
+};
+
+static bool parse_options(int argc, char** argv, options& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view argument = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (argument == "--scene" && has_value)
+        {
+            options.scene_path = argv[++i];
+        }
+        else if (argument == "--random-splines" && has_value)
+        {
+            options.nb_random_splines = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (argument == "--record" && has_value)
+        {
+            options.record_path = argv[++i];
+        }
+        else if (argument == "--replay" && has_value)
+        {
+            options.replay_path = argv[++i];
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--scene FILE] [--random-splines N] [--record FILE | --replay FILE]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool init_scene(data& data, const options& options)
+{
+    if (options.scene_path)
+    {
+        auto scene = MappedScene::Open(options.scene_path);
+        if (!scene)
+        {
+            fprintf(stderr, "%s is not a scene file of this version\n", options.scene_path);
+            return false;
+        }
+        scene->CopyTo(data);
+    }
+    if (options.nb_random_splines > 0)
+    {
+        SceneGenerator::AddRandomSplines(data, 1, options.nb_random_splines, 64);
+    }
+    if (!options.scene_path && options.nb_random_splines == 0)
+    {
+        std::vector<glm::vec2> bezier_control_points = { {0, 0}, {0, 100}, {100, 100}, {100, 0}, {200, 0}, {200, 100}, {200, 200}, {300, 0} };
+        std::vector<glm::vec2> bspline_control_points = { {0, 0}, {0, 100}, {100, 100}, {100, 0}, {200, 0}, {200, 100}, {200, 200}, {300, 0} };
+        data.add_spline(bezier_control_points, spline_type::BEZIER);
+        data.add_spline(bspline_control_points, spline_type::BSPLINE);
+    }
+    return true;
+}
+
+// Plays a recorded session without a window, at a fixed 60 Hz time step, and prints the CPU time of
+// the frames from NewFrame to Render. The scene options must be those of the recording.
+static int replay_session(const char* path, data& data)
+{
+    auto replay = InputReplay::Load(path);
+    if (!replay)
+    {
+        fprintf(stderr, "%s is not an input recording of this version\n", path);
+        return EXIT_FAILURE;
+    }
+
+    IMGUI_CHECKVERSION();
+    ImGui::SetAllocatorFunctions(AllocationCounter::Malloc, AllocationCounter::Free);
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.ConfigInputTrickleEventQueue = false;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+
+    DrawListBuilder discrete_points_builder;
+    discrete_points_builder.Bake(io.Fonts);
+    TaskPool task_pool;
+    FrameArena frame_arena;
+    SceneHistory history;
+    history.Reset(data);
+
+    std::vector<double> frame_ms;
+    std::vector<uint64_t> frame_allocations;
+    frame_ms.reserve(replay->GetNbFrames());
+    frame_allocations.reserve(replay->GetNbFrames());
+    while (replay->Apply(io, 1.f / 60.f))
+    {
+        SPLINE_PROFILE_NEXT_FRAME();
+        const uint64_t begin_ns = Profiler::Now();
+        const uint64_t begin_allocations = AllocationCounter::GetNbAllocations();
+        {
+            SPLINE_PROFILE_SCOPE("Frame");
+            frame_arena.Reset();
+            ImGui::NewFrame();
+            ShowViewportWindow(data, history, task_pool, discrete_points_builder, frame_arena);
+            ImGui::Render();
+        }
+        frame_allocations.push_back(AllocationCounter::GetNbAllocations() - begin_allocations);
+        frame_ms.push_back(static_cast<double>(Profiler::Now() - begin_ns) * 1e-6);
+    }
+    ImGui::DestroyContext();
 
-        ImGui::Begin("Viewport", nullptr, ImGuiWindowFlags_NoCollapse);
+    if (frame_ms.empty())
+    {
+        fprintf(stderr, "%s has no frame\n", path);
+        return EXIT_FAILURE;
+    }
 
-        ImGui::Checkbox("Enable grid", &opt_enable_grid); ImGui::SameLine();
-        ImGui::Checkbox("Enable context menu", &opt_enable_context_menu); ImGui::SameLine();
-        ImGui::Checkbox("Show demo window", &show_window);
-        ImGui::Text("Application average %.1f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
+    // Nearest rank percentiles.
+    std::vector<double> sorted_ms = frame_ms;
+    std::ranges::sort(sorted_ms);
+    auto percentile = [&](double p)
+        {
+            const auto rank = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(sorted_ms.size())));
+            return sorted_ms[std::clamp<size_t>(rank, 1, sorted_ms.size()) - 1];
+        };
+    double total_ms = 0.0;
+    for (double ms : frame_ms)
+    {
+        total_ms += ms;
+    }
+    printf("%zu frames, %zu splines\n", frame_ms.size(), data.get_nb_splines());
+    printf("frame ms : mean %.3f  p50 %.3f  p90 %.3f  p99 %.3f  max %.3f\n", total_ms / static_cast<double>(frame_ms.size()), percentile(50), percentile(90), percentile(99), sorted_ms.back());
+
+    // The first frames fill the caches and grow the buffers that later frames reuse.
+    const size_t nb_warmup_frames = std::min<size_t>(60, frame_allocations.size());
+    const auto steady_allocations = std::span(frame_allocations).subspan(nb_warmup_frames);
+    const size_t nb_allocating_frames = std::ranges::count_if(steady_allocations, [](uint64_t n) { return n > 0; });
+    const uint64_t max_allocations = steady_allocations.empty() ? 0 : std::ranges::max(steady_allocations);
+    printf("heap allocations after %zu frames : %zu frames allocate, at most %llu per frame\n", nb_warmup_frames, nb_allocating_frames, static_cast<unsigned long long>(max_allocations));
+    printf("frame arena : peak %zu bytes, capacity %zu bytes\n", frame_arena.GetPeakBytes(), frame_arena.GetCapacity());
+    return EXIT_SUCCESS;
+}
 
-        ImGui::Text("Mouse Left: drag to add lines,\nMouse Right: drag to scroll, click for context menu.");
-        ImGui::SliderFloat("Point size", &point_radius, 1., 20.);
+int main(int argc, char** argv)
+{
+    options options;
+    data data;
+    if (!parse_options(argc, argv, options) || !init_scene(data, options))
+    {
+        return EXIT_FAILURE;
+    }
 
-        ImVec2 canvas_sz = ImGui::GetContentRegionAvail();
-        if (canvas_sz.x < 50.0f) canvas_sz.x = 50.0f;
-        if (canvas_sz.y < 50.0f) canvas_sz.y = 50.0f;
-        ImVec2 canvas_p0 = ImGui::GetCursorScreenPos();
-        ImVec2 canvas_p1(canvas_p0.x + canvas_sz.x, canvas_p0.y + canvas_sz.y);
+    if (options.replay_path)
+    {
+        return replay_session(options.replay_path, data);
+    }
 
-        // This will catch our interactions
-        ImGui::InvisibleButton("canvas", canvas_sz, ImGuiButtonFlags_MouseButtonLeft | ImGuiButtonFlags_MouseButtonRight);
-        const bool is_canvas_hovered = ImGui::IsItemHovered();
-        const bool is_active = ImGui::IsItemActive();
-        const glm::vec2 origin(canvas_p0.x + scrolling.x, canvas_p0.y + scrolling.y);
-        const glm::vec2 mouse_pos_in_canvas(io.MousePos.x - origin.x, io.MousePos.y - origin.y);
+    GLFWwindow* window = nullptr;
 
-        draw_border(canvas_p0, canvas_p1);
+    init_glfw_and_imgui(window);
 
-        move_point(data, is_canvas_hovered, selected_curve, selected_point, mouse_pos_in_canvas, point_radius);
+    ImGuiIO& io = ImGui::GetIO();
 
-        pan(is_active, opt_enable_context_menu, scrolling);
+    // Recordings start from the default layout, as replays do.
+    InputRecorder recorder;
+    if (options.record_path)
+    {
+        io.IniFilename = nullptr;
+    }
+
+    DrawListBuilder discrete_points_builder;
+    discrete_points_builder.Bake(io.Fonts);
 
-        //draw_context_menu(opt_enable_context_menu, adding_line, points);
+    // Tessellates the visible splines, the UI thread works as one of its threads.
+    TaskPool task_pool;
 
-        draw_grid(opt_enable_grid, canvas_p0, canvas_sz, scrolling);
+    // Temporaries of the frame being drawn.
+    FrameArena frame_arena;
 
-        draw_discrete_points(data, origin);
+    SceneHistory history;
+    history.Reset(data);
 
-        draw_control_points(data, origin, mouse_pos_in_canvas, point_radius);
+    while (!glfwWindowShouldClose(window))
+    {
+        SPLINE_PROFILE_NEXT_FRAME();
+        SPLINE_PROFILE_SCOPE("Frame");
+        frame_arena.Reset();
+
+        // GUI
+        ImGui_ImplOpenGL3_NewFrame();
+        ImGui_ImplGlfw_NewFrame();
+        ImGui::NewFrame();
 
-        if (show_window) { ImGui::ShowDemoWindow(&show_window); }
+        if (options.record_path)
+        {
+            recorder.Record();
+        }
 
-        ShowPropertiesWindow(data);
+        ShowViewportWindow(data, history, task_pool, discrete_points_builder, frame_arena);
 
-        ImGui::GetWindowDrawList()->PopClipRect();
-        ImGui::End();
-        ImGui::Render();
+        {
+            SPLINE_PROFILE_SCOPE("ImGui::Render");
+            ImGui::Render();
+        }
         glClear(GL_COLOR_BUFFER_BIT);
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
@@ -623,6 +1072,11 @@ int main()
         glfwPollEvents();
     }
 
+    if (options.record_path && !recorder.Save(options.record_path))
+    {
+        fprintf(stderr, "Cannot write %s\n", options.record_path);
+    }
+
     shutdown_glfw_and_imgui(window);
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,163 @@
+#include "../profiler/profiler.h"
+
+#include <chrono>
+#include <iomanip>
+#include <ostream>
+
+namespace
+{
+    std::atomic<uint64_t> frame_index = 0;
+    std::atomic<uint32_t> thread_count = 0;
+
+    thread_local uint32_t thread_depth = 0;
+    thread_local const uint32_t thread_id = thread_count.fetch_add(1, std::memory_order_relaxed);
+
+    const auto start_time = std::chrono::steady_clock::now();
+}
+
+void Profiler::EventRingBuffer::Push(const event& e)
+{
+    const uint64_t index = m_head.fetch_add(1, std::memory_order_relaxed);
+    slot& s = m_slots[index % capacity];
+
+    s.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s.name.store(e.name, std::memory_order_relaxed);
+    s.begin_ns.store(e.begin_ns, std::memory_order_relaxed);
+    s.end_ns.store(e.end_ns, std::memory_order_relaxed);
+    s.frame.store(e.frame, std::memory_order_relaxed);
+    s.thread.store(e.thread, std::memory_order_relaxed);
+    s.depth.store(e.depth, std::memory_order_relaxed);
+    s.sequence.store(index + 1, std::memory_order_release);
+}
+
+bool Profiler::EventRingBuffer::Read
+(
+    uint64_t index,
+    event& e
+) const
+{
+    const slot& s = m_slots[index % capacity];
+
+    const uint64_t sequence = s.sequence.load(std::memory_order_acquire);
+    if (sequence != index + 1)
+    {
+        return false;
+    }
+    e.name = s.name.load(std::memory_order_relaxed);
+    e.begin_ns = s.begin_ns.load(std::memory_order_relaxed);
+    e.end_ns = s.end_ns.load(std::memory_order_relaxed);
+    e.frame = s.frame.load(std::memory_order_relaxed);
+    e.thread = s.thread.load(std::memory_order_relaxed);
+    e.depth = s.depth.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    return s.sequence.load(std::memory_order_relaxed) == sequence;
+}
+
+void Profiler::EventRingBuffer::CollectFrame
+(
+    uint64_t frame,
+    std::vector<event>& events
+) const
+{
+    events.clear();
+
+    // Events are pushed when their scope closes, so frames come out in order and the walk
+    // back can stop at the first event of an older frame.
+    const uint64_t head = m_head.load(std::memory_order_acquire);
+    const uint64_t tail = head > capacity ? head - capacity : 0;
+    for (uint64_t index = head; index > tail; --index)
+    {
+        event e;
+        if (!Read(index - 1, e) || e.frame > frame)
+        {
+            continue;
+        }
+        if (e.frame < frame)
+        {
+            break;
+        }
+        events.push_back(e);
+    }
+}
+
+void Profiler::EventRingBuffer::CollectAll
+(
+    std::vector<event>& events
+) const
+{
+    events.clear();
+
+    const uint64_t head = m_head.load(std::memory_order_acquire);
+    const uint64_t tail = head > capacity ? head - capacity : 0;
+    for (uint64_t index = tail; index < head; ++index)
+    {
+        event e;
+        if (Read(index, e))
+        {
+            events.push_back(e);
+        }
+    }
+}
+
+Profiler::Scope::Scope(const char* name)
+    : m_name(name)
+    , m_begin_ns(Now())
+    , m_frame(frame_index.load(std::memory_order_relaxed))
+    , m_depth(thread_depth++)
+{
+}
+
+Profiler::Scope::~Scope()
+{
+    --thread_depth;
+    GetEvents().Push({ m_name, m_begin_ns, Now(), m_frame, thread_id, m_depth });
+}
+
+uint64_t Profiler::Now()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_time).count());
+}
+
+void Profiler::NextFrame()
+{
+    frame_index.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t Profiler::GetFrameIndex()
+{
+    return frame_index.load(std::memory_order_relaxed);
+}
+
+Profiler::EventRingBuffer& Profiler::GetEvents()
+{
+    static EventRingBuffer events;
+    return events;
+}
+
+void Profiler::WriteChromeTrace(std::ostream& out)
+{
+    std::vector<event> all_events;
+    GetEvents().CollectAll(all_events);
+
+    // Timestamps are in microseconds, keep the nanoseconds.
+    const std::ios_base::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    for (size_t i = 0; i < all_events.size(); ++i)
+    {
+        const event& e = all_events[i];
+        out << "{\"name\":\"" << e.name << "\",\"cat\":\"spline\",\"ph\":\"X\",\"pid\":0,\"tid\":" << e.thread
+            << ",\"ts\":" << static_cast<double>(e.begin_ns) * 1e-3
+            << ",\"dur\":" << static_cast<double>(e.end_ns - e.begin_ns) * 1e-3
+            << ",\"args\":{\"frame\":" << e.frame << "}}"
+            << (i + 1 < all_events.size() ? ",\n" : "\n");
+    }
+    out << "]}\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
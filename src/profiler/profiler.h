@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+// Scoped timings of the hot paths. Without SPLINE_ENABLE_PROFILER the macros expand to nothing,
+// so the instrumentation can stay in release builds.
+#ifdef SPLINE_ENABLE_PROFILER
+#define SPLINE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define SPLINE_PROFILE_CONCAT(a, b) SPLINE_PROFILE_CONCAT_IMPL(a, b)
+#define SPLINE_PROFILE_SCOPE(name) const Profiler::Scope SPLINE_PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+#define SPLINE_PROFILE_NEXT_FRAME() Profiler::NextFrame()
+#else
+#define SPLINE_PROFILE_SCOPE(name) ((void)0)
+#define SPLINE_PROFILE_NEXT_FRAME() ((void)0)
+#endif
+
+namespace Profiler
+{
+    struct event
+    {
+        const char* name = nullptr;     // String literal, compared by address.
+        uint64_t begin_ns = 0;
+        uint64_t end_ns = 0;
+        uint64_t frame = 0;
+        uint32_t thread = 0;
+        uint32_t depth = 0;
+    };
+
+    // Fixed size multi-producer ring buffer : writers claim a slot with one fetch_add and never wait,
+    // the oldest events are overwritten. Each slot is a seqlock so that readers skip the slots being rewritten.
+    class EventRingBuffer
+    {
+    public:
+        static constexpr size_t capacity = 1 << 16;
+
+        void Push(const event& e);
+
+        // Events of the given frame still in the buffer, most recent first.
+        void CollectFrame(uint64_t frame, std::vector<event>& events) const;
+
+        // Every event still in the buffer, oldest first.
+        void CollectAll(std::vector<event>& events) const;
+
+    private:
+        struct slot
+        {
+            std::atomic<uint64_t> sequence = 0;     // Index + 1 of the event once written, 0 while writing.
+            std::atomic<const char*> name = nullptr;
+            std::atomic<uint64_t> begin_ns = 0;
+            std::atomic<uint64_t> end_ns = 0;
+            std::atomic<uint64_t> frame = 0;
+            std::atomic<uint32_t> thread = 0;
+            std::atomic<uint32_t> depth = 0;
+        };
+
+        bool Read(uint64_t index, event& e) const;
+
+        std::atomic<uint64_t> m_head = 0;
+        std::array<slot, capacity> m_slots;
+    };
+
+    class Scope
+    {
+    public:
+        explicit Scope(const char* name);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* m_name;
+        uint64_t m_begin_ns;
+        uint64_t m_frame;
+        uint32_t m_depth;
+    };
+
+    uint64_t Now();
+
+    // Frames are delimited by NextFrame, called once at the top of the main loop.
+    void NextFrame();
+    uint64_t GetFrameIndex();
+
+    EventRingBuffer& GetEvents();
+
+    // Chrome trace-event JSON, to open in chrome://tracing or Perfetto.
+    void WriteChromeTrace(std::ostream& out);
+};
@@ -0,0 +1,788 @@
+#include "../scene/scene.h"
+#include "../discretization/discretization.h"
+#include "../profiler/profiler.h"
+
+#include <array>
+#include <cassert>
+#include <span>
+
+namespace
+{
+    struct sample_range
+    {
+        size_t first;
+        size_t last;
+    };
+
+    // Samples t = i / (nb_samples - 1) lying in [t_min, t_max], and the one on either side.
+    sample_range samples_between(size_t nb_samples, double t_min, double t_max)
+    {
+        const size_t last = nb_samples - 1;
+        const double t_step = 1.0 / static_cast<double>(last);
+        const auto first_sample = static_cast<size_t>(std::max(std::ceil(t_min / t_step) - 1.0, 0.0));
+        const auto last_sample = std::min(static_cast<size_t>(std::floor(t_max / t_step) + 1.0), last);
+        return { first_sample, last_sample };
+    }
+
+    // Forward differencing seeds every piece it steps through. It is faster than the batched evaluation
+    // from about 4 samples per curve, and 16 per knot span for B-splines, whose span Bezier form is
+    // computed first.
+    size_t get_min_forward_differencing_samples(const CubicBezierSpline2d& spline) { return 4 * spline.m_curves.size(); }
+    size_t get_min_forward_differencing_samples(const CubicHermiteSpline2d& spline) { return 4 * spline.m_curves.size(); }
+    size_t get_min_forward_differencing_samples(const CubicBSpline2d& spline) { return 16 * (spline.m_ctrl_pts.size() - 3); }
+
+    template <class Spline>
+    void evaluate_samples(const Spline& spline, sample_range samples, std::vector<glm::vec2>& tessellation)
+    {
+        if (tessellation.size() >= get_min_forward_differencing_samples(spline))
+        {
+            const auto nb_samples = static_cast<uint32_t>(tessellation.size());
+            Discretization::ForwardDifferencing(spline, nb_samples, samples.first, std::span(tessellation).subspan(samples.first, samples.last + 1 - samples.first));
+            return;
+        }
+
+        const double t_step = 1.0 / static_cast<double>(tessellation.size() - 1);
+
+        std::array<double, 64> parameters;
+        for (size_t i = samples.first; i <= samples.last; i += parameters.size())
+        {
+            const size_t count = std::min(parameters.size(), samples.last + 1 - i);
+            for (size_t j = 0; j < count; ++j)
+            {
+                parameters[j] = std::min(static_cast<double>(i + j) * t_step, 1.0);
+            }
+            spline.Eval(std::span<const double>(parameters.data(), count), std::span(tessellation).subspan(i, count));
+        }
+    }
+
+    // Evaluates again the samples lying in [t_min, t_max].
+    template <class Spline>
+    void retessellate(const Spline& spline, double t_min, double t_max, std::vector<glm::vec2>& tessellation)
+    {
+        if (tessellation.size() < 2)
+        {
+            return;
+        }
+        evaluate_samples(spline, samples_between(tessellation.size(), t_min, t_max), tessellation);
+    }
+
+    // Bezier and Hermite points after the last whole curve are on no segment.
+    bool is_on_segment(const spline_variant& spline, size_t point_index)
+    {
+        if (auto* bezier = std::get_if<CubicBezierSpline2d>(&spline))
+        {
+            return point_index / 4 < bezier->m_curves.size();
+        }
+        if (auto* hermite = std::get_if<CubicHermiteSpline2d>(&spline))
+        {
+            return point_index / 4 < hermite->m_curves.size();
+        }
+        return true;
+    }
+
+    // Bezier form of the segments depending on the control point, the same local support as above.
+    template <class Visit>
+    void for_each_segment_of_point(const spline_variant& spline, size_t point_index, Visit&& visit)
+    {
+        if (!is_on_segment(spline, point_index))
+        {
+            return;
+        }
+
+        if (auto* bezier = std::get_if<CubicBezierSpline2d>(&spline))
+        {
+            const size_t curve = point_index / 4;
+            visit(curve, bezier->m_curves[curve]);
+        }
+        else if (auto* hermite = std::get_if<CubicHermiteSpline2d>(&spline))
+        {
+            const size_t curve = point_index / 4;
+            visit(curve, CubicBezierCurve2d::FromCubicHermiteCurve2d(hermite->m_curves[curve]));
+        }
+        else if (auto* bspline = std::get_if<CubicBSpline2d>(&spline))
+        {
+            const size_t first_span = std::max<size_t>(point_index, 3);
+            const size_t last_span = std::min(point_index + 3, bspline->m_ctrl_pts.size() - 1);
+            for (size_t span = first_span; span <= last_span; ++span)
+            {
+                visit(span - 3, bspline->GetSpanBezierCurve(span));
+            }
+        }
+    }
+
+    // Exact bounds of every segment, straight from the control points.
+    void compute_segment_bounds(spline_type type, std::span<const glm::vec2> points, std::vector<BoundingBox2d>& segment_bounds)
+    {
+        segment_bounds.clear();
+        switch (type)
+        {
+            using enum spline_type;
+        case BEZIER:
+        {
+            for (size_t i = 0; i + 3 < points.size(); i += 4)
+            {
+                segment_bounds.push_back(CubicBezierCurve2d(points[i], points[i + 1], points[i + 2], points[i + 3]).GetBounds());
+            }
+        } break;
+        case HERMITE:
+        {
+            for (size_t i = 0; i + 3 < points.size(); i += 4)
+            {
+                segment_bounds.push_back(CubicHermiteCurve2d(points[i], points[i + 1], points[i + 2], points[i + 3]).GetBounds());
+            }
+        } break;
+        case BSPLINE:
+        {
+            if (points.size() > 3)
+            {
+                for (const CubicBezierCurve2d& curve : CubicBezierSpline2d::FromCubicBSplinePoints2d(points).m_curves)
+                {
+                    segment_bounds.push_back(curve.GetBounds());
+                }
+            }
+        } break;
+        default: break;
+        }
+    }
+
+    BoundingBox2d union_of(std::span<const BoundingBox2d> boxes)
+    {
+        BoundingBox2d box;
+        for (const auto& b : boxes)
+        {
+            box.Extend(b);
+        }
+        return box;
+    }
+}
+
+size_t data::get_nb_splines() const
+{
+    return splines_point_range.size();
+}
+
+std::span<glm::vec2> data::get_points(size_t index)
+{
+    const point_range range = splines_point_range[index];
+    return std::span(points_pool).subspan(range.offset, range.count);
+}
+
+std::span<const glm::vec2> data::get_points(size_t index) const
+{
+    const point_range range = splines_point_range[index];
+    return std::span(points_pool).subspan(range.offset, range.count);
+}
+
+void data::set_points
+(
+    size_t index,
+    std::span<const glm::vec2> points
+)
+{
+    // Fewer points stay in place, more are moved to the end of the pool.
+    point_range& range = splines_point_range[index];
+    const auto count = static_cast<uint32_t>(points.size());
+    if (count <= range.count)
+    {
+        free_points({ range.offset + count, range.count - count });
+        range.count = count;
+    }
+    else
+    {
+        free_points(range);
+        range = { allocate_points(count), count };
+    }
+    std::ranges::copy(points, points_pool.begin() + range.offset);
+
+    if (2 * nb_free_points > points_pool.size())
+    {
+        compact_points();
+    }
+    invalidate_spline(index);
+}
+
+spline_handle data::get_handle(size_t index) const
+{
+    const uint32_t slot = splines_slot[index];
+    return { slot, slots[slot].generation };
+}
+
+std::optional<size_t> data::find_spline(spline_handle handle) const
+{
+    if (handle.slot >= slots.size() || slots[handle.slot].generation != handle.generation)
+    {
+        return std::nullopt;
+    }
+    return slots[handle.slot].index;
+}
+
+void data::add_spline
+(
+    std::span<const glm::vec2> spline_points,
+    const spline_type spline_type,
+    const glm::uvec3 spline_color,
+    const int32_t spline_discretization
+)
+{
+    insert_spline(get_nb_splines(), spline_points, spline_type, spline_color, spline_discretization);
+}
+
+void data::insert_spline
+(
+    size_t index,
+    std::span<const glm::vec2> spline_points,
+    const spline_type spline_type,
+    const glm::uvec3 spline_color,
+    const int32_t spline_discretization
+)
+{
+    assert(index <= get_nb_splines());
+
+    const auto count = static_cast<uint32_t>(spline_points.size());
+    const uint32_t offset = allocate_points(count);
+    std::ranges::copy(spline_points, points_pool.begin() + offset);
+
+    uint32_t slot;
+    if (free_slots.empty())
+    {
+        slot = static_cast<uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+    else
+    {
+        slot = free_slots.back();
+        free_slots.pop_back();
+    }
+
+    // Added last, then swapped with the spline in the way.
+    const size_t last = get_nb_splines();
+    slots[slot].index = static_cast<uint32_t>(last);
+    splines_point_range.push_back({ offset, count });
+    splines_type.push_back(spline_type);
+    splines_color.push_back(spline_color);
+    splines_discretization.push_back(spline_discretization);
+    splines_draw_options.push_back(draw_option::NONE);
+    splines_slot.push_back(slot);
+
+    spline_cache& cache = splines_cache.emplace_back();
+    compute_segment_bounds(spline_type, spline_points, cache.segment_bounds);
+    cache.control_points_bounds = BoundingBox2d::FromPoints(spline_points);
+    splines_bounding_boxs.push_back(union_of(cache.segment_bounds));
+
+    swap_splines(index, last);
+    control_points_hash.InsertSpline(index, spline_points);
+    ++generation;
+}
+
+void data::remove_spline(size_t index)
+{
+    assert(index < get_nb_splines());
+
+    const uint32_t slot = splines_slot[index];
+    ++slots[slot].generation;
+    free_slots.push_back(slot);
+    free_points(splines_point_range[index]);
+
+    // Swapped with the last spline, then dropped.
+    swap_splines(index, get_nb_splines() - 1);
+    splines_point_range.pop_back();
+    splines_type.pop_back();
+    splines_color.pop_back();
+    splines_discretization.pop_back();
+    splines_draw_options.pop_back();
+    splines_bounding_boxs.pop_back();
+    splines_cache.pop_back();
+    splines_slot.pop_back();
+    control_points_hash.RemoveSpline(index);
+    ++generation;
+
+    if (2 * nb_free_points > points_pool.size())
+    {
+        compact_points();
+    }
+}
+
+void data::clear()
+{
+    const uint64_t previous_generation = generation;
+    const float tolerance = discretization_tolerance;
+
+    // Slots are kept so that the handles to the removed splines are not found in the next ones.
+    std::vector<spline_slot> previous_slots = std::move(slots);
+    *this = data();
+    for (uint32_t i = 0; i < previous_slots.size(); ++i)
+    {
+        ++previous_slots[i].generation;
+        free_slots.push_back(static_cast<uint32_t>(previous_slots.size()) - 1 - i);
+    }
+    slots = std::move(previous_slots);
+
+    generation = previous_generation + 1;
+    discretization_tolerance = tolerance;
+}
+
+void data::invalidate_spline(size_t index)
+{
+    const bool is_splines_bvh_current = splines_bvh_generation == generation;
+
+    spline_cache& cache = splines_cache[index];
+    const std::span<const glm::vec2> points = get_points(index);
+    compute_segment_bounds(splines_type[index], points, cache.segment_bounds);
+    cache.control_points_bounds = BoundingBox2d::FromPoints(points);
+    splines_bounding_boxs[index] = union_of(cache.segment_bounds);
+    control_points_hash.UpdateSpline(index, points);
+    ++cache.generation;
+    ++generation;
+
+    if (is_splines_bvh_current)
+    {
+        splines_bvh.Update(index, get_drawn_bounds(index));
+        splines_bvh_generation = generation;
+    }
+}
+
+void data::invalidate_adaptive_splines()
+{
+    // Only the tessellations change, the trees stay current.
+    const bool is_segments_bvh_current = segments_bvh_generation == generation;
+    const bool is_splines_bvh_current = splines_bvh_generation == generation;
+
+    for (size_t i = 0; i < splines_cache.size(); i++)
+    {
+        if (static_cast<bool>(splines_draw_options[i] & draw_option::ADAPTIVE_DISCRETIZATION))
+        {
+            ++splines_cache[i].generation;
+            ++generation;
+        }
+    }
+
+    segments_bvh_generation = is_segments_bvh_current ? generation : segments_bvh_generation;
+    splines_bvh_generation = is_splines_bvh_current ? generation : splines_bvh_generation;
+}
+
+void data::move_control_point(size_t index, size_t point_index, const glm::vec2& position)
+{
+    SPLINE_PROFILE_SCOPE("data::move_control_point");
+
+    const std::span<glm::vec2> points = get_points(index);
+    const glm::vec2 previous_position = points[point_index];
+    points[point_index] = position;
+    control_points_hash.MovePoint(index, point_index, position);
+
+    spline_cache& cache = splines_cache[index];
+    BoundingBox2d& control_points_bounds = cache.control_points_bounds;
+    if (glm::any(glm::equal(previous_position, control_points_bounds.min)) || glm::any(glm::equal(previous_position, control_points_bounds.max)))
+    {
+        control_points_bounds = BoundingBox2d::FromPoints(points);
+    }
+    else
+    {
+        control_points_bounds.Extend(position);
+    }
+
+    const bool is_cached = cache.tessellation_generation == cache.generation;
+    const bool is_adaptive = static_cast<bool>(splines_draw_options[index] & draw_option::ADAPTIVE_DISCRETIZATION);
+    if (!is_cached || is_adaptive || std::holds_alternative<std::monostate>(cache.spline) || !is_on_segment(cache.spline, point_index))
+    {
+        invalidate_spline(index);
+        return;
+    }
+
+    // Bezier and Hermite points only act on their own curve, B-spline points on the 4 spans
+    // following their first knot.
+    if (auto* bezier = std::get_if<CubicBezierSpline2d>(&cache.spline))
+    {
+        const size_t curve = point_index / 4;
+        const auto nb_curves = static_cast<double>(bezier->m_curves.size());
+        bezier->m_curves[curve].P[point_index % 4] = position;
+        retessellate(*bezier, static_cast<double>(curve) / nb_curves, static_cast<double>(curve + 1) / nb_curves, cache.tessellation);
+    }
+    else if (auto* hermite = std::get_if<CubicHermiteSpline2d>(&cache.spline))
+    {
+        const size_t curve = point_index / 4;
+        const auto nb_curves = static_cast<double>(hermite->m_curves.size());
+        hermite->m_curves[curve] = CubicHermiteCurve2d(points[curve * 4], points[curve * 4 + 1], points[curve * 4 + 2], points[curve * 4 + 3]);
+        retessellate(*hermite, static_cast<double>(curve) / nb_curves, static_cast<double>(curve + 1) / nb_curves, cache.tessellation);
+    }
+    else if (auto* bspline = std::get_if<CubicBSpline2d>(&cache.spline))
+    {
+        bspline->m_ctrl_pts[point_index] = position;
+        retessellate(*bspline, bspline->m_knots[point_index], bspline->m_knots[point_index + 4], cache.tessellation);
+    }
+
+    // The trees are patched as well when they were up to date.
+    const bool is_segments_bvh_current = segments_bvh_generation == generation && segments_bvh.HasSpline(index);
+    const bool is_splines_bvh_current = splines_bvh_generation == generation;
+
+    // The spline box only needs a full pass over the segment boxes when one of the
+    // changed segments was on one of its sides.
+    BoundingBox2d& bbox = splines_bounding_boxs[index];
+    bool may_shrink = false;
+    for_each_segment_of_point(cache.spline, point_index, [&](size_t segment, const CubicBezierCurve2d& curve)
+        {
+            BoundingBox2d& segment_box = cache.segment_bounds[segment];
+            may_shrink = may_shrink || glm::any(glm::equal(segment_box.min, bbox.min)) || glm::any(glm::equal(segment_box.max, bbox.max));
+            segment_box = curve.GetBounds();
+            bbox.Extend(segment_box);
+            if (is_segments_bvh_current)
+            {
+                segments_bvh.UpdateSegment(index, segment, curve);
+            }
+        });
+    if (may_shrink)
+    {
+        bbox = union_of(cache.segment_bounds);
+    }
+
+    ++cache.generation;
+    cache.tessellation_generation = cache.generation;
+    ++generation;
+
+    if (is_segments_bvh_current)
+    {
+        segments_bvh_generation = generation;
+    }
+    if (is_splines_bvh_current)
+    {
+        splines_bvh.Update(index, get_drawn_bounds(index));
+        splines_bvh_generation = generation;
+    }
+}
+
+const SegmentBvh2d& data::get_segments_bvh()
+{
+    if (segments_bvh_generation == generation)
+    {
+        return segments_bvh;
+    }
+
+    SPLINE_PROFILE_SCOPE("data::get_segments_bvh");
+
+    std::vector<SegmentBvh2d::Segment> segments;
+    for (size_t i = 0; i < get_nb_splines(); i++)
+    {
+        std::visit([&](const auto& spline)
+            {
+                using spline_t = std::decay_t<decltype(spline)>;
+                if constexpr (!std::is_same_v<spline_t, std::monostate>)
+                {
+                    SegmentBvh2d::AppendSegments(spline, static_cast<uint32_t>(i), segments);
+                }
+            }, get_spline(i));
+    }
+    segments_bvh.Build(std::move(segments));
+    segments_bvh_generation = generation;
+
+    return segments_bvh;
+}
+
+const Bvh2d& data::get_splines_bvh()
+{
+    if (splines_bvh_generation != generation)
+    {
+        std::vector<BoundingBox2d> boxes(get_nb_splines());
+        for (size_t i = 0; i < boxes.size(); ++i)
+        {
+            boxes[i] = get_drawn_bounds(i);
+        }
+        splines_bvh.Build(boxes);
+        splines_bvh_generation = generation;
+    }
+    return splines_bvh;
+}
+
+std::optional<SegmentBvh2d::ClosestPoint> data::find_closest_curve_point(const glm::vec2& position, float max_distance)
+{
+    return get_segments_bvh().FindClosest(position, max_distance);
+}
+
+std::vector<CurveIntersection::Intersection> data::find_intersections(float tolerance)
+{
+    SPLINE_PROFILE_SCOPE("data::find_intersections");
+
+    return CurveIntersection::FindIntersections(get_segments_bvh().GetSegments(), tolerance);
+}
+
+std::optional<SpatialHash2d::Item> data::find_control_point(const glm::vec2& position, float radius) const
+{
+    return control_points_hash.FindNearest(position, radius);
+}
+
+const spline_variant& data::get_spline(size_t index)
+{
+    if (splines_cache[index].tessellation_generation != splines_cache[index].generation)
+    {
+        build_spline(index);
+    }
+    return splines_cache[index].spline;
+}
+
+const std::vector<glm::vec2>& data::get_tessellation(size_t index)
+{
+    get_spline(index);
+    const size_t nb_segments = splines_cache[index].tessellated_segments.size();
+    if (nb_segments > 0)
+    {
+        get_tessellation(index, 0, nb_segments - 1);
+    }
+    return splines_cache[index].tessellation;
+}
+
+std::span<const glm::vec2> data::get_tessellation(size_t index, size_t first_segment, size_t last_segment)
+{
+    get_spline(index);
+
+    spline_cache& cache = splines_cache[index];
+    if (cache.tessellated_segments.empty() || cache.tessellation.size() < 2)
+    {
+        return cache.tessellation;
+    }
+    assert(first_segment <= last_segment && last_segment < cache.tessellated_segments.size());
+
+    // Every segment covers the same range of parameters, the B-spline knots are uniform too.
+    const auto nb_segments = static_cast<double>(cache.tessellated_segments.size());
+    for (size_t segment = first_segment; segment <= last_segment;)
+    {
+        if (cache.tessellated_segments[segment])
+        {
+            ++segment;
+            continue;
+        }
+
+        SPLINE_PROFILE_SCOPE("data::get_tessellation");
+
+        const size_t first_missing = segment;
+        for (; segment <= last_segment && !cache.tessellated_segments[segment]; ++segment)
+        {
+            cache.tessellated_segments[segment] = 1;
+        }
+        std::visit([&](const auto& spline)
+            {
+                using spline_t = std::decay_t<decltype(spline)>;
+                if constexpr (!std::is_same_v<spline_t, std::monostate>)
+                {
+                    retessellate(spline, static_cast<double>(first_missing) / nb_segments, static_cast<double>(segment) / nb_segments, cache.tessellation);
+                }
+            }, cache.spline);
+    }
+
+    const auto last = static_cast<double>(cache.tessellation.size() - 1);
+    const auto first_sample = static_cast<size_t>(std::floor(static_cast<double>(first_segment) / nb_segments * last));
+    const auto last_sample = std::min(static_cast<size_t>(std::ceil(static_cast<double>(last_segment + 1) / nb_segments * last)), cache.tessellation.size() - 1);
+    return std::span<const glm::vec2>(cache.tessellation).subspan(first_sample, last_sample + 1 - first_sample);
+}
+
+void data::tessellate
+(
+    TaskPool& pool,
+    std::span<const tessellation_range> ranges,
+    std::pmr::memory_resource* memory
+)
+{
+    SPLINE_PROFILE_SCOPE("data::tessellate");
+
+    // Splines and adaptive tessellations are built first, one spline per call.
+    std::pmr::vector<uint32_t> stale_splines(memory);
+    for (const tessellation_range& range : ranges)
+    {
+        if (splines_cache[range.spline].tessellation_generation != splines_cache[range.spline].generation)
+        {
+            stale_splines.push_back(range.spline);
+        }
+    }
+    std::ranges::sort(stale_splines);
+    const auto [first_duplicate, end] = std::ranges::unique(stale_splines);
+    stale_splines.erase(first_duplicate, end);
+
+    pool.ParallelFor(stale_splines.size(), 16, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                build_spline(stale_splines[i]);
+            }
+        });
+
+    // Missing segments are flagged here, and their samples gathered in disjoint chunks so that no
+    // two threads write the same sample : neighbouring runs share their end samples and are merged.
+    struct chunk
+    {
+        uint32_t spline;
+        sample_range samples;
+    };
+    constexpr size_t chunk_size = 256;
+
+    std::pmr::vector<chunk> chunks(memory);
+    for (size_t r = 0; r < ranges.size(); ++r)
+    {
+        const tessellation_range& range = ranges[r];
+        assert(r == 0 || ranges[r - 1].spline != range.spline || ranges[r - 1].last_segment < range.first_segment);
+
+        spline_cache& cache = splines_cache[range.spline];
+        if (cache.tessellated_segments.empty() || cache.tessellation.size() < 2)
+        {
+            continue;
+        }
+        assert(range.first_segment <= range.last_segment && range.last_segment < cache.tessellated_segments.size());
+
+        const auto nb_segments = static_cast<double>(cache.tessellated_segments.size());
+        for (size_t segment = range.first_segment; segment <= range.last_segment;)
+        {
+            if (cache.tessellated_segments[segment])
+            {
+                ++segment;
+                continue;
+            }
+
+            const size_t first_missing = segment;
+            for (; segment <= range.last_segment && !cache.tessellated_segments[segment]; ++segment)
+            {
+                cache.tessellated_segments[segment] = 1;
+            }
+
+            sample_range samples = samples_between(cache.tessellation.size(), static_cast<double>(first_missing) / nb_segments, static_cast<double>(segment) / nb_segments);
+            if (!chunks.empty() && chunks.back().spline == range.spline && samples.first <= chunks.back().samples.last + 1)
+            {
+                samples.first = chunks.back().samples.first;
+                chunks.pop_back();
+            }
+            for (; samples.last + 1 - samples.first > chunk_size; samples.first += chunk_size)
+            {
+                chunks.push_back({ range.spline, { samples.first, samples.first + chunk_size - 1 } });
+            }
+            chunks.push_back({ range.spline, samples });
+        }
+    }
+
+    pool.ParallelFor(chunks.size(), 4, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                spline_cache& cache = splines_cache[chunks[i].spline];
+                std::visit([&](const auto& spline)
+                    {
+                        using spline_t = std::decay_t<decltype(spline)>;
+                        if constexpr (!std::is_same_v<spline_t, std::monostate>)
+                        {
+                            evaluate_samples(spline, chunks[i].samples, cache.tessellation);
+                        }
+                    }, cache.spline);
+            }
+        });
+}
+
+void data::build_spline(size_t index)
+{
+    SPLINE_PROFILE_SCOPE("data::build_spline");
+
+    spline_cache& cache = splines_cache[index];
+    const std::span<const glm::vec2> control_points = get_points(index);
+    switch (splines_type[index])
+    {
+        using enum spline_type;
+    case BEZIER: { cache.spline.emplace<CubicBezierSpline2d>(control_points);  } break;
+    case HERMITE: { cache.spline.emplace<CubicHermiteSpline2d>(control_points); } break;
+    case BSPLINE: { cache.spline.emplace<CubicBSpline2d>(control_points);       } break;
+    default:                                                                        break;
+    }
+
+    // Uniform samples are only laid out here, get_tessellation evaluates them.
+    cache.tessellation.clear();
+    cache.tessellated_segments.clear();
+    auto adaptive = static_cast<bool>(splines_draw_options[index] & draw_option::ADAPTIVE_DISCRETIZATION);
+    std::visit([&](const auto& spline)
+        {
+            using spline_t = std::decay_t<decltype(spline)>;
+            if constexpr (!std::is_same_v<spline_t, std::monostate>)
+            {
+                if (adaptive)
+                {
+                    cache.tessellation = Discretization::Adaptive(spline, discretization_tolerance);
+                }
+                else
+                {
+                    cache.tessellation.resize(static_cast<size_t>(std::max(splines_discretization[index], 0)));
+                    cache.tessellated_segments.assign(cache.segment_bounds.size(), 0);
+                }
+            }
+        }, cache.spline);
+    cache.tessellation_generation = cache.generation;
+}
+
+uint32_t data::allocate_points(size_t count)
+{
+    assert(points_pool.size() + count <= UINT32_MAX);
+
+    const auto offset = static_cast<uint32_t>(points_pool.size());
+    points_pool.resize(points_pool.size() + count);
+    return offset;
+}
+
+void data::free_points(point_range range)
+{
+    // A range at the end of the pool is given back at once, e.g. when undoing an add.
+    if (range.offset + range.count == points_pool.size())
+    {
+        points_pool.resize(range.offset);
+    }
+    else
+    {
+        nb_free_points += range.count;
+    }
+}
+
+void data::compact_points()
+{
+    SPLINE_PROFILE_SCOPE("data::compact_points");
+
+    std::vector<glm::vec2> pool;
+    pool.reserve(points_pool.size() - nb_free_points);
+    for (point_range& range : splines_point_range)
+    {
+        const auto begin = points_pool.begin() + range.offset;
+        range.offset = static_cast<uint32_t>(pool.size());
+        pool.insert(pool.end(), begin, begin + range.count);
+    }
+    points_pool = std::move(pool);
+    nb_free_points = 0;
+}
+
+BoundingBox2d data::get_drawn_bounds(size_t index) const
+{
+    BoundingBox2d box = splines_cache[index].control_points_bounds;
+    box.Extend(splines_bounding_boxs[index]);
+    return box;
+}
+
+void data::swap_splines
+(
+    size_t a,
+    size_t b
+)
+{
+    if (a == b)
+    {
+        return;
+    }
+
+    std::swap(splines_point_range[a], splines_point_range[b]);
+    std::swap(splines_type[a], splines_type[b]);
+    std::swap(splines_color[a], splines_color[b]);
+    std::swap(splines_discretization[a], splines_discretization[b]);
+    std::swap(splines_draw_options[a], splines_draw_options[b]);
+    std::swap(splines_bounding_boxs[a], splines_bounding_boxs[b]);
+
+    // Field by field, GCC sees the variant of a whole cache swap as maybe uninitialized.
+    spline_cache& cache_a = splines_cache[a];
+    spline_cache& cache_b = splines_cache[b];
+    std::swap(cache_a.generation, cache_b.generation);
+    std::swap(cache_a.tessellation_generation, cache_b.tessellation_generation);
+    cache_a.spline.swap(cache_b.spline);
+    cache_a.tessellation.swap(cache_b.tessellation);
+    cache_a.tessellated_segments.swap(cache_b.tessellated_segments);
+    cache_a.segment_bounds.swap(cache_b.segment_bounds);
+    std::swap(cache_a.control_points_bounds, cache_b.control_points_bounds);
+
+    std::swap(splines_slot[a], splines_slot[b]);
+    slots[splines_slot[a]].index = static_cast<uint32_t>(a);
+    slots[splines_slot[b]].index = static_cast<uint32_t>(b);
+}
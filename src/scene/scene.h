@@ -0,0 +1,244 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <variant>
+#include <vector>
+
+#include "../cubic_bezier_spline_2d/cubic_bezier_spline_2d.h"
+#include "../cubic_hermite_spline_2d/cubic_hermite_spline_2d.h"
+#include "../cubic_bspline_2d/cubic_bspline_2d.h"
+#include "../spatial_hash_2d/spatial_hash_2d.h"
+#include "../segment_bvh_2d/segment_bvh_2d.h"
+#include "../curve_intersection/curve_intersection.h"
+#include "../bvh_2d/bvh_2d.h"
+#include "../bounding_box_2d/bounding_box_2d.h"
+#include "../task_pool/task_pool.h"
+
+enum class spline_type : uint32_t
+{
+    BEZIER,
+    HERMITE,
+    BSPLINE
+};
+
+enum class draw_option : uint32_t
+{
+    NONE = 0,
+    CONTROL_POLYGON = 1 << 0,
+    NORMALS = 1 << 1,
+    BBOX = 1 << 2,
+    ADAPTIVE_DISCRETIZATION = 1 << 3
+};
+
+constexpr draw_option operator|(draw_option a, draw_option b)
+{
+    return static_cast<draw_option>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+}
+
+inline draw_option operator&(draw_option a, draw_option b)
+{
+    return static_cast<draw_option>(static_cast<uint32_t>(a) & static_cast<uint32_t>(b));
+}
+
+inline draw_option& operator|=(draw_option& a, draw_option b)
+{
+    a = a | b;
+    return a;
+}
+
+inline draw_option& operator&=(draw_option& a, draw_option b)
+{
+    a = a & b;
+    return a;
+}
+
+inline draw_option& operator^=(draw_option& a, draw_option b)
+{
+    a = static_cast<draw_option>(static_cast<uint32_t>(a) ^ static_cast<uint32_t>(b));
+    return a;
+}
+
+inline draw_option operator~(draw_option a)
+{
+    return static_cast<draw_option>(~static_cast<uint32_t>(a));
+}
+
+// Every flag of draw_option, the other bits mean nothing.
+constexpr draw_option all_draw_options = draw_option::CONTROL_POLYGON | draw_option::NORMALS | draw_option::BBOX | draw_option::ADAPTIVE_DISCRETIZATION;
+
+// Segments per curve or knot span of uniform tessellations, as the editor offers them.
+constexpr int32_t min_discretization = 2;
+constexpr int32_t max_discretization = 200;
+
+// Segments first_segment to last_segment of a spline, as get_tessellation takes them.
+struct tessellation_range
+{
+    uint32_t spline;
+    uint32_t first_segment;
+    uint32_t last_segment;
+};
+
+using spline_variant = std::variant<std::monostate, CubicBezierSpline2d, CubicHermiteSpline2d, CubicBSpline2d>;
+
+// Spline object and tessellation built from the control points, valid while
+// tessellation_generation matches generation. Uniform tessellations are evaluated segment by
+// segment on first use, tessellated_segments is empty for adaptive ones which are built whole.
+// The segment and control point bounds are always up to date.
+struct spline_cache
+{
+    uint64_t generation = 0;
+    uint64_t tessellation_generation = UINT64_MAX;
+    spline_variant spline;
+    std::vector<glm::vec2> tessellation;
+    std::vector<uint8_t> tessellated_segments;
+    std::vector<BoundingBox2d> segment_bounds;
+    BoundingBox2d control_points_bounds;
+};
+
+// Control points points_pool[offset, offset + count) of a spline.
+struct point_range
+{
+    uint32_t offset = 0;
+    uint32_t count = 0;
+};
+
+// Names a spline while the removal of others moves it to another index. Handles of a removed
+// spline are not found anymore, even once its slot is reused.
+struct spline_handle
+{
+    uint32_t slot = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool operator==(const spline_handle&) const = default;
+};
+
+// Splines are stored by index in parallel arrays, removing one moves the last spline in its place.
+struct data
+{
+    // Control points of every spline, one range each. Removed and relocated ranges leave holes,
+    // the pool is compacted once they make up half of it.
+    std::vector<glm::vec2> points_pool;
+    std::vector<point_range> splines_point_range;
+    size_t nb_free_points = 0;
+
+    std::vector<spline_type> splines_type;
+    std::vector<glm::uvec3> splines_color;
+    std::vector<int32_t> splines_discretization;
+    std::vector<draw_option> splines_draw_options;
+    std::vector<BoundingBox2d> splines_bounding_boxs;      // Exact bounds of the curves, not of the control points.
+    std::vector<spline_cache> splines_cache;
+    std::vector<uint32_t> splines_slot;
+    float discretization_tolerance = 0.25f;
+
+    // Index of the spline of every slot in use, and generation of the slot, bumped when its spline is removed.
+    struct spline_slot
+    {
+        uint32_t index = 0;
+        uint32_t generation = 0;
+    };
+    std::vector<spline_slot> slots;
+    std::vector<uint32_t> free_slots;
+
+    // Every control point by position, for picking and hover.
+    SpatialHash2d control_points_hash;
+
+    // Every curve segment, rebuilt on demand when segments_bvh_generation is behind generation.
+    SegmentBvh2d segments_bvh;
+    uint64_t segments_bvh_generation = UINT64_MAX;
+
+    // Bounds of the curves and control points of the splines, all that is drawn of them, refitted
+    // as they change and rebuilt after an add or remove.
+    Bvh2d splines_bvh;
+    uint64_t splines_bvh_generation = UINT64_MAX;
+
+    // Bumped by every change of the scene geometry.
+    uint64_t generation = 0;
+
+    size_t get_nb_splines() const;
+    std::span<glm::vec2> get_points(size_t index);
+    std::span<const glm::vec2> get_points(size_t index) const;
+
+    // Replaces the control points, their count may change, and invalidates the spline.
+    void set_points(size_t index, std::span<const glm::vec2> points);
+
+    spline_handle get_handle(size_t index) const;
+    std::optional<size_t> find_spline(spline_handle handle) const;
+
+    // The points must not come from the scene itself.
+    void add_spline
+    (
+        std::span<const glm::vec2> spline_points,
+        const spline_type spline_type,
+        const glm::uvec3 spline_color = glm::uvec3(255, 255, 255),
+        const int32_t spline_discretization = 100
+    );
+
+    // The spline at index moves to the end, which undoes the removal of a spline.
+    void insert_spline
+    (
+        size_t index,
+        std::span<const glm::vec2> spline_points,
+        const spline_type spline_type,
+        const glm::uvec3 spline_color = glm::uvec3(255, 255, 255),
+        const int32_t spline_discretization = 100
+    );
+
+    // The last spline moves to index.
+    void remove_spline(size_t index);
+
+    // Removes every spline. The generation keeps increasing so that nothing cached for them is reused.
+    void clear();
+
+    // Must be called after editing the points, type, discretization or draw options of a spline.
+    void invalidate_spline(size_t index);
+    void invalidate_adaptive_splines();
+
+    // Moves one control point. Uniform tessellations are patched over the local support of
+    // the point only, as are the spline object, the bounds and the trees ; adaptive ones are rebuilt.
+    void move_control_point(size_t index, size_t point_index, const glm::vec2& position);
+
+    // Control point closest to position within radius.
+    std::optional<SpatialHash2d::Item> find_control_point(const glm::vec2& position, float radius) const;
+
+    // Point of the curves closest to position within max_distance.
+    std::optional<SegmentBvh2d::ClosestPoint> find_closest_curve_point(const glm::vec2& position, float max_distance);
+    const SegmentBvh2d& get_segments_bvh();
+
+    // Crossings between the curves of every pair of splines, within tolerance of both of them.
+    std::vector<CurveIntersection::Intersection> find_intersections(float tolerance);
+    const Bvh2d& get_splines_bvh();
+
+    // Cached spline object and polyline, rebuilt only when the spline was invalidated.
+    const spline_variant& get_spline(size_t index);
+    const std::vector<glm::vec2>& get_tessellation(size_t index);
+
+    // Samples of the segments first_segment to last_segment, and the samples on either side so that
+    // the polyline reaches their ends. Only these segments are evaluated ; adaptive tessellations
+    // are returned whole.
+    std::span<const glm::vec2> get_tessellation(size_t index, size_t first_segment, size_t last_segment);
+
+    // Evaluates the ranges on the pool, after which get_tessellation returns them without evaluating
+    // anything. The ranges of a spline follow each other by increasing segments, without overlap.
+    // Samples are split in chunks of the same size, so a long spline is spread over every thread.
+    // The lists of stale splines and chunks are allocated from memory, e.g. the frame arena.
+    void tessellate(TaskPool& pool, std::span<const tessellation_range> ranges, std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+private:
+    void build_spline(size_t index);
+    BoundingBox2d get_drawn_bounds(size_t index) const;
+
+    // Offset of count new points at the end of the pool.
+    uint32_t allocate_points(size_t count);
+    void free_points(point_range range);
+    void compact_points();
+
+    // Swaps every per spline array, but not the trees and the hash.
+    void swap_splines(size_t a, size_t b);
+};
@@ -0,0 +1,310 @@
+#include "../scene_file/scene_file.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static_assert(std::endian::native == std::endian::little, "scene files are read in place, as little-endian");
+
+namespace
+{
+    constexpr uint64_t alignment = 16;
+
+    uint64_t align_up(uint64_t offset)
+    {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+
+    uint32_t pack_color(const glm::uvec3& color)
+    {
+        return (color.r & 0xFF) | (color.g & 0xFF) << 8 | (color.b & 0xFF) << 16;
+    }
+
+    // Sections within the file and records within the points, without overflow on corrupted sizes.
+    bool is_valid(const SceneFile::header& h, size_t file_size)
+    {
+        const bool is_header_valid = std::memcmp(h.magic, SceneFile::magic, sizeof(h.magic)) == 0
+            && h.version == SceneFile::version
+            && h.header_size == sizeof(SceneFile::header)
+            && h.file_size == file_size;
+        if (!is_header_valid)
+        {
+            return false;
+        }
+
+        const bool are_offsets_valid = h.splines_offset % alignment == 0
+            && h.points_offset % alignment == 0
+            && h.splines_offset >= sizeof(SceneFile::header)
+            && h.splines_offset <= file_size
+            && h.points_offset <= file_size;
+        if (!are_offsets_valid)
+        {
+            return false;
+        }
+
+        return h.nb_splines <= (file_size - h.splines_offset) / sizeof(SceneFile::spline_record)
+            && h.nb_points <= (file_size - h.points_offset) / sizeof(glm::vec2)
+            && (h.points_offset >= h.splines_offset + h.nb_splines * sizeof(SceneFile::spline_record)
+                || h.nb_splines == 0);
+    }
+
+    // Points within the file, and enough of them for the spline constructors : a whole curve for
+    // Bezier splines, whole curves for Hermite ones and the 4 points of a span for B-splines. The
+    // discretization sizes the tessellation, it must be one the editor offers.
+    bool is_valid(const SceneFile::spline_record& record, uint64_t nb_points)
+    {
+        const bool are_points_valid = record.first_point <= nb_points
+            && record.nb_points <= nb_points - record.first_point;
+        if (!are_points_valid
+            || record.discretization < min_discretization
+            || record.discretization > max_discretization)
+        {
+            return false;
+        }
+
+        switch (static_cast<spline_type>(record.type))
+        {
+        case spline_type::BEZIER:   return record.nb_points >= 4;
+        case spline_type::HERMITE:  return record.nb_points >= 4 && record.nb_points % 4 == 0;
+        case spline_type::BSPLINE:  return record.nb_points >= 4;
+        default:                    return false;
+        }
+    }
+}
+
+bool SceneFile::Write(const char* path, const data& data)
+{
+    const size_t nb_splines = data.get_nb_splines();
+
+    header h{};
+    std::memcpy(h.magic, magic, sizeof(magic));
+    h.version = version;
+    h.header_size = sizeof(header);
+    h.nb_splines = nb_splines;
+    h.splines_offset = align_up(sizeof(header));
+    h.points_offset = align_up(h.splines_offset + nb_splines * sizeof(spline_record));
+
+    std::vector<spline_record> records(nb_splines);
+    for (size_t i = 0; i < nb_splines; ++i)
+    {
+        records[i].first_point = h.nb_points;
+        records[i].nb_points = static_cast<uint32_t>(data.get_points(i).size());
+        records[i].type = static_cast<uint32_t>(data.splines_type[i]);
+        records[i].color = pack_color(data.splines_color[i]);
+        records[i].discretization = data.splines_discretization[i];
+        records[i].draw_options = static_cast<uint32_t>(data.splines_draw_options[i]);
+        h.nb_points += records[i].nb_points;
+    }
+    h.file_size = h.points_offset + h.nb_points * sizeof(glm::vec2);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+
+    const char padding[alignment] = {};
+    file.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    file.write(padding, static_cast<std::streamsize>(h.splines_offset - sizeof(h)));
+    file.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(spline_record)));
+    file.write(padding, static_cast<std::streamsize>(h.points_offset - h.splines_offset - records.size() * sizeof(spline_record)));
+    for (size_t i = 0; i < nb_splines; ++i)
+    {
+        const std::span<const glm::vec2> points = data.get_points(i);
+        file.write(reinterpret_cast<const char*>(points.data()), static_cast<std::streamsize>(points.size() * sizeof(glm::vec2)));
+    }
+
+    return static_cast<bool>(file.flush());
+}
+
+std::optional<MappedScene> MappedScene::Open(const char* path)
+{
+    MappedScene scene;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return std::nullopt;
+    }
+    scene.m_file = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < static_cast<LONGLONG>(sizeof(SceneFile::header)))
+    {
+        return std::nullopt;
+    }
+    scene.m_size = static_cast<size_t>(size.QuadPart);
+
+    scene.m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!scene.m_mapping)
+    {
+        return std::nullopt;
+    }
+    scene.m_data = static_cast<const std::byte*>(MapViewOfFile(scene.m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!scene.m_data)
+    {
+        return std::nullopt;
+    }
+#else
+    const int file = open(path, O_RDONLY);
+    if (file < 0)
+    {
+        return std::nullopt;
+    }
+
+    struct stat status;
+    const bool is_large_enough = fstat(file, &status) == 0 && status.st_size >= static_cast<off_t>(sizeof(SceneFile::header));
+    void* address = is_large_enough ? mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0) : MAP_FAILED;
+    close(file);
+    if (address == MAP_FAILED)
+    {
+        return std::nullopt;
+    }
+    scene.m_data = static_cast<const std::byte*>(address);
+    scene.m_size = static_cast<size_t>(status.st_size);
+#endif
+
+    const auto& h = *reinterpret_cast<const SceneFile::header*>(scene.m_data);
+    if (!is_valid(h, scene.m_size))
+    {
+        return std::nullopt;
+    }
+
+    scene.m_splines = { reinterpret_cast<const SceneFile::spline_record*>(scene.m_data + h.splines_offset), static_cast<size_t>(h.nb_splines) };
+    scene.m_points = { reinterpret_cast<const glm::vec2*>(scene.m_data + h.points_offset), static_cast<size_t>(h.nb_points) };
+
+    // The records are checked once here so that the accessors can trust them, the points are not read.
+    for (const SceneFile::spline_record& record : scene.m_splines)
+    {
+        if (!is_valid(record, h.nb_points))
+        {
+            return std::nullopt;
+        }
+    }
+
+    return scene;
+}
+
+MappedScene::MappedScene(MappedScene&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedScene& MappedScene::operator=(MappedScene&& other) noexcept
+{
+    if (this != &other)
+    {
+        Unmap();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_splines = std::exchange(other.m_splines, {});
+        m_points = std::exchange(other.m_points, {});
+#ifdef _WIN32
+        m_file = std::exchange(other.m_file, nullptr);
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+    }
+    return *this;
+}
+
+MappedScene::~MappedScene()
+{
+    Unmap();
+}
+
+void MappedScene::Unmap()
+{
+#ifdef _WIN32
+    if (m_data)
+    {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping)
+    {
+        CloseHandle(m_mapping);
+    }
+    if (m_file)
+    {
+        CloseHandle(m_file);
+    }
+    m_file = nullptr;
+    m_mapping = nullptr;
+#else
+    if (m_data)
+    {
+        munmap(const_cast<std::byte*>(m_data), m_size);
+    }
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_splines = {};
+    m_points = {};
+}
+
+size_t MappedScene::GetNbSplines() const
+{
+    return m_splines.size();
+}
+
+size_t MappedScene::GetNbPoints() const
+{
+    return m_points.size();
+}
+
+std::span<const glm::vec2> MappedScene::GetPoints(size_t spline) const
+{
+    const SceneFile::spline_record& record = m_splines[spline];
+    return m_points.subspan(static_cast<size_t>(record.first_point), record.nb_points);
+}
+
+spline_type MappedScene::GetType(size_t spline) const
+{
+    return static_cast<spline_type>(m_splines[spline].type);
+}
+
+glm::uvec3 MappedScene::GetColor(size_t spline) const
+{
+    const uint32_t color = m_splines[spline].color;
+    return glm::uvec3(color & 0xFF, (color >> 8) & 0xFF, (color >> 16) & 0xFF);
+}
+
+int32_t MappedScene::GetDiscretization(size_t spline) const
+{
+    return m_splines[spline].discretization;
+}
+
+draw_option MappedScene::GetDrawOptions(size_t spline) const
+{
+    return static_cast<draw_option>(m_splines[spline].draw_options) & all_draw_options;
+}
+
+void MappedScene::CopyTo(data& data) const
+{
+    for (size_t i = 0; i < GetNbSplines(); ++i)
+    {
+        const std::span<const glm::vec2> points = GetPoints(i);
+        if (!std::ranges::all_of(points, [](const glm::vec2& p) { return std::isfinite(p.x) && std::isfinite(p.y); }))
+        {
+            continue;
+        }
+        data.add_spline(points, GetType(i), GetColor(i), GetDiscretization(i));
+        data.splines_draw_options.back() = GetDrawOptions(i);
+    }
+}
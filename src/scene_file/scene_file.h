@@ -0,0 +1,96 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "../scene/scene.h"
+
+// Binary scene file, laid out to be mapped in memory and read in place :
+//
+//  header          64 bytes
+//  spline_record   32 bytes per spline, at splines_offset
+//  glm::vec2       control points of every spline one after the other, at points_offset
+//
+// Integers and floats are little-endian, sections are aligned on 16 bytes.
+namespace SceneFile
+{
+    constexpr char magic[8] = { 'S', 'P', 'L', 'I', 'N', 'E', 'S', '\0' };
+    constexpr uint32_t version = 1;
+
+    struct header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t header_size;
+        uint64_t file_size;
+        uint64_t nb_splines;
+        uint64_t nb_points;
+        uint64_t splines_offset;
+        uint64_t points_offset;
+        uint64_t reserved;
+    };
+
+    struct spline_record
+    {
+        uint64_t first_point;       // Index in the points section.
+        uint32_t nb_points;
+        uint32_t type;              // spline_type
+        uint32_t color;             // 0x00BBGGRR
+        int32_t discretization;
+        uint32_t draw_options;      // draw_option flags
+        uint32_t reserved;
+    };
+
+    static_assert(sizeof(header) == 64);
+    static_assert(sizeof(spline_record) == 32);
+    static_assert(sizeof(glm::vec2) == 8);
+
+    // Returns false when the file cannot be written.
+    bool Write(const char* path, const data& data);
+};
+
+// Scene file mapped read-only. Opening validates the header and the spline records, the control
+// points are used in place and only read from disk as they are touched.
+class MappedScene
+{
+public:
+    // Empty when the file cannot be mapped or is not a valid scene file of this version.
+    static std::optional<MappedScene> Open(const char* path);
+
+    MappedScene(MappedScene&& other) noexcept;
+    MappedScene& operator=(MappedScene&& other) noexcept;
+    ~MappedScene();
+
+    MappedScene(const MappedScene&) = delete;
+    MappedScene& operator=(const MappedScene&) = delete;
+
+    size_t GetNbSplines() const;
+    size_t GetNbPoints() const;
+
+    std::span<const glm::vec2> GetPoints(size_t spline) const;
+    spline_type GetType(size_t spline) const;
+    glm::uvec3 GetColor(size_t spline) const;
+    int32_t GetDiscretization(size_t spline) const;
+    draw_option GetDrawOptions(size_t spline) const;     // Unknown flags cleared.
+
+    // Adds every spline to the editor scene, which keeps its own copy of the points. The points are
+    // first read here, splines with a NaN or infinite point are skipped.
+    void CopyTo(data& data) const;
+
+private:
+    MappedScene() = default;
+
+    void Unmap();
+
+    const std::byte* m_data = nullptr;
+    size_t m_size = 0;
+    std::span<const SceneFile::spline_record> m_splines;
+    std::span<const glm::vec2> m_points;
+#ifdef _WIN32
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#endif
+};
@@ -0,0 +1,72 @@
+#include "../scene_generator/scene_generator.h"
+
+#include <array>
+#include <cassert>
+#include <numbers>
+#include <random>
+
+std::vector<glm::vec2> SceneGenerator::RandomControlPoints
+(
+    uint32_t seed,
+    size_t nb_ctrl_pts,
+    float step_length
+)
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> turn(-0.5f, 0.5f);
+    std::uniform_real_distribution<float> stretch(0.5f, 1.5f);
+    std::uniform_real_distribution<float> heading(0.f, 2.f * std::numbers::pi_v<float>);
+
+    std::vector<glm::vec2> ctrl_pts(nb_ctrl_pts);
+    glm::vec2 position(0.f);
+    float angle = heading(generator);
+    for (auto& ctrl_pt : ctrl_pts)
+    {
+        ctrl_pt = position;
+        angle += turn(generator);
+        position += step_length * stretch(generator) * glm::vec2(std::cos(angle), std::sin(angle));
+    }
+
+    return ctrl_pts;
+}
+
+void SceneGenerator::AddRandomSplines
+(
+    data& data,
+    uint32_t seed,
+    size_t nb_splines,
+    size_t nb_ctrl_pts,
+    float extent
+)
+{
+    assert(nb_ctrl_pts > 3);
+
+    constexpr std::array<spline_type, 3> types = { spline_type::BEZIER, spline_type::HERMITE, spline_type::BSPLINE };
+
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> offset(0.f, extent);
+    std::uniform_int_distribution<uint32_t> channel(64, 255);
+
+    for (size_t i = 0; i < nb_splines; ++i)
+    {
+        const spline_type type = types[i % types.size()];
+        const size_t nb_pts = type == spline_type::BSPLINE ? nb_ctrl_pts : nb_ctrl_pts - nb_ctrl_pts % 4;
+
+        std::vector<glm::vec2> ctrl_pts = RandomControlPoints(static_cast<uint32_t>(generator()), nb_pts);
+        glm::vec2 origin;
+        origin.x = offset(generator);
+        origin.y = offset(generator);
+        for (auto& ctrl_pt : ctrl_pts)
+        {
+            ctrl_pt += origin;
+        }
+
+        // One draw per statement, the evaluation order of arguments is unspecified.
+        glm::uvec3 color;
+        color.r = channel(generator);
+        color.g = channel(generator);
+        color.b = channel(generator);
+
+        data.add_spline(ctrl_pts, type, color);
+    }
+}
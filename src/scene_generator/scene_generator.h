@@ -0,0 +1,18 @@
+#pragma once
+
+#include "../scene/scene.h"
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace SceneGenerator
+{
+    // Reproducible control polygon : a random walk of nb_ctrl_pts points with steps of about step_length
+    // that turns smoothly, as drawn by hand. Bezier and Hermite need a multiple of 4 points.
+    std::vector<glm::vec2> RandomControlPoints( uint32_t seed, size_t nb_ctrl_pts, float step_length = 20.f );
+
+    // Adds nb_splines splines of nb_ctrl_pts control points, cycling through the spline types,
+    // spread over a square of side extent.
+    void AddRandomSplines( data& data, uint32_t seed, size_t nb_splines, size_t nb_ctrl_pts, float extent = 4096.f );
+};
@@ -0,0 +1,320 @@
+#include "../scene_history/scene_history.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+SceneHistory::state_ptr SceneHistory::Snapshot
+(
+    const data& data,
+    size_t index,
+    const state_ptr& previous
+)
+{
+    const std::span<const glm::vec2> points = data.get_points(index);
+    const size_t nb_chunks = (points.size() + chunk_size - 1) / chunk_size;
+
+    auto state = std::make_shared<spline_state>();
+    state->nb_points = points.size();
+    state->type = data.splines_type[index];
+    state->color = data.splines_color[index];
+    state->discretization = data.splines_discretization[index];
+    state->draw_options = data.splines_draw_options[index];
+    state->chunks.reserve(nb_chunks);
+
+    bool is_unchanged = previous
+        && previous->nb_points == state->nb_points
+        && previous->type == state->type
+        && previous->color == state->color
+        && previous->discretization == state->discretization
+        && previous->draw_options == state->draw_options;
+
+    for (size_t i = 0; i < nb_chunks; ++i)
+    {
+        const size_t first = i * chunk_size;
+        const size_t count = std::min(chunk_size, points.size() - first);
+        const auto begin = points.begin() + static_cast<std::ptrdiff_t>(first);
+        const auto end = begin + static_cast<std::ptrdiff_t>(count);
+
+        // A chunk is shared when it holds the same points, its last one can be partly used.
+        const bool is_shared = previous
+            && i < previous->chunks.size()
+            && count == std::min(chunk_size, previous->nb_points - first)
+            && std::equal(begin, end, previous->chunks[i]->points.begin());
+        if (is_shared)
+        {
+            state->chunks.push_back(previous->chunks[i]);
+        }
+        else
+        {
+            auto copy = std::make_shared<chunk>();
+            std::copy(begin, end, copy->points.begin());
+            state->chunks.push_back(std::move(copy));
+            is_unchanged = false;
+        }
+    }
+
+    return is_unchanged ? previous : state;
+}
+
+size_t SceneHistory::CountNewBytes
+(
+    const spline_state& state,
+    const spline_state* previous
+)
+{
+    size_t nb_bytes = sizeof(spline_state) + state.chunks.capacity() * sizeof(state_ptr);
+    for (size_t i = 0; i < state.chunks.size(); ++i)
+    {
+        const bool is_shared = previous && i < previous->chunks.size() && previous->chunks[i] == state.chunks[i];
+        nb_bytes += is_shared ? 0 : sizeof(chunk);
+    }
+    return nb_bytes;
+}
+
+std::vector<glm::vec2> SceneHistory::GetPoints(const spline_state& state)
+{
+    std::vector<glm::vec2> points(state.nb_points);
+    for (size_t i = 0; i < state.chunks.size(); ++i)
+    {
+        const size_t first = i * chunk_size;
+        const size_t count = std::min(chunk_size, state.nb_points - first);
+        std::copy_n(state.chunks[i]->points.begin(), count, points.begin() + static_cast<std::ptrdiff_t>(first));
+    }
+    return points;
+}
+
+void SceneHistory::Restore
+(
+    data& data,
+    size_t index,
+    const spline_state& state
+)
+{
+    data.splines_type[index] = state.type;
+    data.splines_color[index] = state.color;
+    data.splines_discretization[index] = state.discretization;
+    data.splines_draw_options[index] = state.draw_options;
+    data.set_points(index, GetPoints(state));
+}
+
+void SceneHistory::Insert
+(
+    data& data,
+    size_t index,
+    const spline_state& state
+)
+{
+    data.insert_spline(index, GetPoints(state), state.type, state.color, state.discretization);
+    data.splines_draw_options[index] = state.draw_options;
+}
+
+void SceneHistory::Reset(const data& data)
+{
+    m_splines.clear();
+    m_splines.reserve(data.get_nb_splines());
+    for (size_t i = 0; i < data.get_nb_splines(); ++i)
+    {
+        m_splines.push_back(Snapshot(data, i, nullptr));
+    }
+    m_marked.clear();
+    m_entries.clear();
+    m_nb_applied = 0;
+    m_nb_bytes = 0;
+}
+
+void SceneHistory::MarkChanged(size_t index)
+{
+    // A drag marks the same spline every frame.
+    if (m_marked.empty() || m_marked.back() != index)
+    {
+        m_marked.push_back(index);
+    }
+}
+
+void SceneHistory::Commit(const data& data)
+{
+    CommitMarked(data, SIZE_MAX);
+}
+
+void SceneHistory::CommitMarked
+(
+    const data& data,
+    size_t removed_index
+)
+{
+    if (m_marked.empty())
+    {
+        return;
+    }
+
+    std::ranges::sort(m_marked);
+    const auto duplicates = std::ranges::unique(m_marked);
+    m_marked.erase(duplicates.begin(), duplicates.end());
+
+    entry entry;
+    for (size_t index : m_marked)
+    {
+        // The last edits of a removed spline are lost, the removal keeps its committed state.
+        assert(index < m_splines.size());
+        if (index == removed_index)
+        {
+            continue;
+        }
+
+        const size_t scene_index = removed_index < index && index == m_splines.size() - 1 ? removed_index : index;
+        state_ptr after = Snapshot(data, scene_index, m_splines[index]);
+        if (after != m_splines[index])
+        {
+            entry.nb_bytes += CountNewBytes(*after, m_splines[index].get());
+            entry.changes.push_back({ index, m_splines[index], after });
+            m_splines[index] = std::move(after);
+        }
+    }
+    m_marked.clear();
+
+    if (!entry.changes.empty())
+    {
+        Push(std::move(entry));
+    }
+}
+
+void SceneHistory::CommitAddedSplines
+(
+    const data& data,
+    size_t first_index
+)
+{
+    assert(first_index == m_splines.size());
+
+    Commit(data);
+
+    entry entry;
+    for (size_t i = first_index; i < data.get_nb_splines(); ++i)
+    {
+        state_ptr after = Snapshot(data, i, nullptr);
+        entry.nb_bytes += CountNewBytes(*after, nullptr);
+        entry.changes.push_back({ i, nullptr, after });
+        m_splines.push_back(std::move(after));
+    }
+
+    if (!entry.changes.empty())
+    {
+        Push(std::move(entry));
+    }
+}
+
+void SceneHistory::CommitRemovedSpline
+(
+    const data& data,
+    size_t index
+)
+{
+    assert(index < m_splines.size());
+
+    CommitMarked(data, index);
+
+    // The state is kept alive by the entry, the removal itself adds nothing.
+    entry entry;
+    entry.changes.push_back({ index, m_splines[index], nullptr });
+    m_splines[index] = std::move(m_splines.back());
+    m_splines.pop_back();
+    Push(std::move(entry));
+}
+
+void SceneHistory::Push(entry entry)
+{
+    // A new edit drops the entries that were undone.
+    for (size_t i = m_nb_applied; i < m_entries.size(); ++i)
+    {
+        m_nb_bytes -= m_entries[i].nb_bytes;
+    }
+    m_entries.resize(m_nb_applied);
+
+    m_nb_bytes += entry.nb_bytes;
+    m_entries.push_back(std::move(entry));
+    ++m_nb_applied;
+}
+
+void SceneHistory::Apply
+(
+    data& data,
+    const change& change,
+    bool is_undo
+)
+{
+    const state_ptr& target = is_undo ? change.before : change.after;
+    const state_ptr& source = is_undo ? change.after : change.before;
+
+    // Splines move as in the scene : the last one fills a removed spline, and the one in the way of
+    // an inserted spline goes last.
+    if (source && target)
+    {
+        Restore(data, change.index, *target);
+        m_splines[change.index] = target;
+    }
+    else if (source)
+    {
+        data.remove_spline(change.index);
+        m_splines[change.index] = std::move(m_splines.back());
+        m_splines.pop_back();
+    }
+    else
+    {
+        Insert(data, change.index, *target);
+        m_splines.push_back(target);
+        std::swap(m_splines[change.index], m_splines.back());
+    }
+}
+
+bool SceneHistory::Undo(data& data)
+{
+    Commit(data);
+    if (!CanUndo())
+    {
+        return false;
+    }
+
+    const entry& entry = m_entries[--m_nb_applied];
+    for (auto it = entry.changes.rbegin(); it != entry.changes.rend(); ++it)
+    {
+        Apply(data, *it, true);
+    }
+    return true;
+}
+
+bool SceneHistory::Redo(data& data)
+{
+    Commit(data);
+    if (!CanRedo())
+    {
+        return false;
+    }
+
+    const entry& entry = m_entries[m_nb_applied++];
+    for (const change& change : entry.changes)
+    {
+        Apply(data, change, false);
+    }
+    return true;
+}
+
+bool SceneHistory::CanUndo() const
+{
+    return m_nb_applied > 0;
+}
+
+bool SceneHistory::CanRedo() const
+{
+    return m_nb_applied < m_entries.size();
+}
+
+size_t SceneHistory::GetNbEntries() const
+{
+    return m_entries.size();
+}
+
+size_t SceneHistory::GetMemoryUsage() const
+{
+    return m_nb_bytes;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../scene/scene.h"
+
+// Undo and redo of the scene edits. The history keeps the state of every spline as of the last
+// commit, with the control points split in chunks that are shared, never copied, by the states
+// that did not change them. An entry holds the states before and after its edit of the splines it
+// touched, so it only costs the chunks the edit changed.
+//
+// Edits are marked as they happen and turned into one entry by Commit : a drag marks its spline
+// every frame and commits once released.
+class SceneHistory
+{
+public:
+    static constexpr size_t chunk_size = 64;
+
+    struct chunk
+    {
+        std::array<glm::vec2, chunk_size> points;
+    };
+
+    struct spline_state
+    {
+        std::vector<std::shared_ptr<const chunk>> chunks;
+        size_t nb_points = 0;
+        spline_type type = spline_type::BEZIER;
+        glm::uvec3 color = glm::uvec3(255);
+        int32_t discretization = 0;
+        draw_option draw_options = draw_option::NONE;
+    };
+
+    // Starts over from the scene as it is, without any entry.
+    void Reset(const data& data);
+
+    // The points or the properties of the spline changed since the last commit.
+    void MarkChanged(size_t index);
+
+    // One entry for the splines marked since the last commit, that did change. Cheap when nothing
+    // was marked, to call every frame the scene is not being edited.
+    void Commit(const data& data);
+
+    // One entry each, right after adding the splines from first_index to the end of the scene and
+    // after removing one. Marked edits are committed before, on their own.
+    void CommitAddedSplines(const data& data, size_t first_index);
+    void CommitRemovedSpline(const data& data, size_t index);
+
+    // Return false when there is nothing to undo or redo.
+    bool Undo(data& data);
+    bool Redo(data& data);
+
+    bool CanUndo() const;
+    bool CanRedo() const;
+    size_t GetNbEntries() const;
+
+    // Bytes of the chunks and states the entries added, what the history costs above the scene.
+    size_t GetMemoryUsage() const;
+
+private:
+    using state_ptr = std::shared_ptr<const spline_state>;
+
+    // before is null for an added spline, after for a removed one.
+    struct change
+    {
+        size_t index;
+        state_ptr before;
+        state_ptr after;
+    };
+
+    struct entry
+    {
+        std::vector<change> changes;
+        size_t nb_bytes = 0;
+    };
+
+    // State of the spline in the scene, sharing the chunks of previous that did not change.
+    static state_ptr Snapshot(const data& data, size_t index, const state_ptr& previous);
+    static size_t CountNewBytes(const spline_state& state, const spline_state* previous);
+    static std::vector<glm::vec2> GetPoints(const spline_state& state);
+    static void Restore(data& data, size_t index, const spline_state& state);
+    static void Insert(data& data, size_t index, const spline_state& state);
+
+    // Marked indices are those of the last commit, removed_index is a spline removed from the scene
+    // since, whose place was taken by the last one.
+    void CommitMarked(const data& data, size_t removed_index);
+    void Push(entry entry);
+    void Apply(data& data, const change& change, bool is_undo);
+
+    std::vector<state_ptr> m_splines;       // As of the last commit, in the order of the scene.
+    std::vector<size_t> m_marked;
+    std::vector<entry> m_entries;
+    size_t m_nb_applied = 0;                // Entries before it are undone by Undo, from it redone by Redo.
+    size_t m_nb_bytes = 0;
+};
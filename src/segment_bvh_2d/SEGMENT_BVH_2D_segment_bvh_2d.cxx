@@ -0,0 +1,227 @@
+#include "../segment_bvh_2d/segment_bvh_2d.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+namespace
+{
+    struct projection
+    {
+        float u;
+        glm::vec2 point;
+        float distance2;
+    };
+
+    // Closest point of the curve to p : the best of a few samples, refined by Newton's method on
+    // f(u) = (B(u) - p) . B'(u), whose roots are the feet of the normals from p.
+    projection Project(const CubicBezierCurve2d& curve, const glm::vec2& p)
+    {
+        constexpr size_t nb_samples = 16;
+        constexpr int nb_iterations = 5;
+
+        static const std::array<float, nb_samples + 1> samples_u = []()
+            {
+                std::array<float, nb_samples + 1> u;
+                for (size_t i = 0; i <= nb_samples; ++i)
+                {
+                    u[i] = static_cast<float>(i) / nb_samples;
+                }
+                return u;
+            }();
+
+        std::array<glm::vec2, nb_samples + 1> samples;
+        curve.Eval(samples_u, samples);
+
+        projection best = { 0.f, samples[0], glm::dot(samples[0] - p, samples[0] - p) };
+        for (size_t i = 1; i <= nb_samples; ++i)
+        {
+            const float distance2 = glm::dot(samples[i] - p, samples[i] - p);
+            if (distance2 < best.distance2)
+            {
+                best = { samples_u[i], samples[i], distance2 };
+            }
+        }
+
+        float u = best.u;
+        for (int i = 0; i < nb_iterations; ++i)
+        {
+            const glm::vec2 d = curve.Eval(u) - p;
+            const glm::vec2 d1 = curve.EvalFirstDerivative(u);
+            const glm::vec2 d2 = curve.EvalSecondDerivative(u);
+            const float f = glm::dot(d, d1);
+            const float df = glm::dot(d1, d1) + glm::dot(d, d2);
+            if (df <= 0.f)
+            {
+                break;
+            }
+
+            const float next = std::clamp(u - f / df, 0.f, 1.f);
+            if (std::abs(next - u) < 1e-7f)
+            {
+                break;
+            }
+            u = next;
+        }
+
+        const glm::vec2 point = curve.Eval(u);
+        const float distance2 = glm::dot(point - p, point - p);
+        return distance2 < best.distance2 ? projection{ u, point, distance2 } : best;
+    }
+}
+
+void SegmentBvh2d::AppendSegments
+(
+    const CubicBezierSpline2d& cubic_bezier_spline_2d,
+    uint32_t spline,
+    std::vector<Segment>& segments
+)
+{
+    const auto nb_curves = static_cast<double>(cubic_bezier_spline_2d.m_curves.size());
+    for (size_t i = 0; i < cubic_bezier_spline_2d.m_curves.size(); ++i)
+    {
+        segments.push_back({ cubic_bezier_spline_2d.m_curves[i], spline, static_cast<uint32_t>(i), static_cast<double>(i) / nb_curves, static_cast<double>(i + 1) / nb_curves });
+    }
+}
+
+void SegmentBvh2d::AppendSegments
+(
+    const CubicHermiteSpline2d& cubic_hermite_spline_2d,
+    uint32_t spline,
+    std::vector<Segment>& segments
+)
+{
+    const auto nb_curves = static_cast<double>(cubic_hermite_spline_2d.m_curves.size());
+    for (size_t i = 0; i < cubic_hermite_spline_2d.m_curves.size(); ++i)
+    {
+        const CubicBezierCurve2d curve = CubicBezierCurve2d::FromCubicHermiteCurve2d(cubic_hermite_spline_2d.m_curves[i]);
+        segments.push_back({ curve, spline, static_cast<uint32_t>(i), static_cast<double>(i) / nb_curves, static_cast<double>(i + 1) / nb_curves });
+    }
+}
+
+void SegmentBvh2d::AppendSegments
+(
+    const CubicBSpline2d& cubic_bspline_2d,
+    uint32_t spline,
+    std::vector<Segment>& segments
+)
+{
+    const CubicBezierSpline2d bezier_spline = CubicBezierSpline2d::FromCubicBSpline2d(cubic_bspline_2d);
+    for (size_t span = 3; span < cubic_bspline_2d.m_ctrl_pts.size(); ++span)
+    {
+        segments.push_back({ bezier_spline.m_curves[span - 3], spline, static_cast<uint32_t>(span - 3), cubic_bspline_2d.m_knots[span], cubic_bspline_2d.m_knots[span + 1] });
+    }
+}
+
+void SegmentBvh2d::Build(std::vector<Segment> segments)
+{
+    m_segments = std::move(segments);
+
+    m_spline_first_segment.clear();
+    std::vector<BoundingBox2d> boxes(m_segments.size());
+    for (size_t i = 0; i < m_segments.size(); ++i)
+    {
+        const Segment& segment = m_segments[i];
+        if (segment.spline >= m_spline_first_segment.size())
+        {
+            m_spline_first_segment.resize(segment.spline + 1, UINT32_MAX);
+        }
+        if (m_spline_first_segment[segment.spline] == UINT32_MAX)
+        {
+            m_spline_first_segment[segment.spline] = static_cast<uint32_t>(i);
+        }
+        assert(m_spline_first_segment[segment.spline] + segment.index == i);
+
+        boxes[i] = segment.curve.GetBounds();
+    }
+
+    m_bvh.Build(boxes);
+}
+
+void SegmentBvh2d::Clear()
+{
+    Build({});
+}
+
+void SegmentBvh2d::UpdateSegment
+(
+    size_t spline,
+    size_t index,
+    const CubicBezierCurve2d& curve
+)
+{
+    assert(HasSpline(spline));
+
+    const size_t i = m_spline_first_segment[spline] + index;
+    assert(m_segments[i].spline == spline && m_segments[i].index == index);
+
+    m_segments[i].curve = curve;
+    m_bvh.Update(i, curve.GetBounds());
+}
+
+bool SegmentBvh2d::HasSpline(size_t spline) const
+{
+    return spline < m_spline_first_segment.size() && m_spline_first_segment[spline] != UINT32_MAX;
+}
+
+std::optional<SegmentBvh2d::ClosestPoint> SegmentBvh2d::FindClosest
+(
+    const glm::vec2& point,
+    float max_distance
+) const
+{
+    projection closest{};
+    size_t closest_segment = SIZE_MAX;
+    m_bvh.FindNearest(point, max_distance * max_distance, [&](size_t i, float best_distance2)
+        {
+            const projection candidate = Project(m_segments[i].curve, point);
+            if (candidate.distance2 >= best_distance2)
+            {
+                return best_distance2;
+            }
+            closest = candidate;
+            closest_segment = i;
+            return candidate.distance2;
+        });
+
+    if (closest_segment == SIZE_MAX)
+    {
+        return std::nullopt;
+    }
+
+    const Segment& segment = m_segments[closest_segment];
+    return ClosestPoint
+    {
+        segment.spline,
+        segment.index,
+        segment.t0 + static_cast<double>(closest.u) * (segment.t1 - segment.t0),
+        closest.point,
+        std::sqrt(closest.distance2)
+    };
+}
+
+void SegmentBvh2d::FindClosest
+(
+    std::span<const glm::vec2> points,
+    float max_distance,
+    std::span< std::optional<ClosestPoint> > closest
+) const
+{
+    assert(points.size() == closest.size());
+
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        closest[i] = FindClosest(points[i], max_distance);
+    }
+}
+
+float SegmentBvh2d::Distance(const glm::vec2& point) const
+{
+    const std::optional<ClosestPoint> closest = FindClosest(point);
+    return closest ? closest->distance : INFINITY;
+}
+
+const std::vector<SegmentBvh2d::Segment>& SegmentBvh2d::GetSegments() const
+{
+    return m_segments;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "../bvh_2d/bvh_2d.h"
+#include "../cubic_bezier_spline_2d/cubic_bezier_spline_2d.h"
+#include "../cubic_hermite_spline_2d/cubic_hermite_spline_2d.h"
+#include "../cubic_bspline_2d/cubic_bspline_2d.h"
+
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+// Bvh2d over the cubic segments of many splines, each segment in Bezier form : Bezier and Hermite
+// curves, B-spline spans. Answers closest point on curve queries.
+class SegmentBvh2d
+{
+public:
+    // Segment index within its spline, covering the spline parameters [t0, t1].
+    struct Segment
+    {
+        CubicBezierCurve2d curve;
+        uint32_t spline;
+        uint32_t index;
+        double t0;
+        double t1;
+    };
+
+    struct ClosestPoint
+    {
+        uint32_t spline;
+        uint32_t segment;
+        double t;               // Parameter on the spline.
+        glm::vec2 point;
+        float distance;
+    };
+
+    static void AppendSegments(const CubicBezierSpline2d& cubic_bezier_spline_2d, uint32_t spline, std::vector<Segment>& segments);
+    static void AppendSegments(const CubicHermiteSpline2d& cubic_hermite_spline_2d, uint32_t spline, std::vector<Segment>& segments);
+    static void AppendSegments(const CubicBSpline2d& cubic_bspline_2d, uint32_t spline, std::vector<Segment>& segments);
+
+    // Segments of a spline must be contiguous and in order, as given by AppendSegments.
+    void Build(std::vector<Segment> segments);
+    void Clear();
+
+    // Replaces the curve of one segment and refits the tree.
+    void UpdateSegment(size_t spline, size_t index, const CubicBezierCurve2d& curve);
+    bool HasSpline(size_t spline) const;
+
+    std::optional<ClosestPoint> FindClosest(const glm::vec2& point, float max_distance = INFINITY) const;
+    void FindClosest(std::span<const glm::vec2> points, float max_distance, std::span< std::optional<ClosestPoint> > closest) const;
+
+    // Distance from point to the closest curve, INFINITY when there are none.
+    float Distance(const glm::vec2& point) const;
+
+    const std::vector<Segment>& GetSegments() const;
+
+private:
+    std::vector<Segment> m_segments;
+    std::vector<uint32_t> m_spline_first_segment;   // Per spline index, UINT32_MAX when it has no segment.
+    Bvh2d m_bvh;
+};
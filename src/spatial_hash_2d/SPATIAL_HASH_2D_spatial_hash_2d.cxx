@@ -0,0 +1,233 @@
+#include "../spatial_hash_2d/spatial_hash_2d.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+SpatialHash2d::SpatialHash2d(float cell_size)
+    : m_cell_size(cell_size)
+{
+    assert(cell_size > 0.f);
+}
+
+void SpatialHash2d::Clear()
+{
+    m_cells.clear();
+    m_point_cells.clear();
+}
+
+void SpatialHash2d::InsertSpline
+(
+    size_t spline,
+    std::span<const glm::vec2> points
+)
+{
+    assert(spline <= m_point_cells.size());
+
+    // The spline in the way moves to the end, the new one takes its place.
+    const size_t last = m_point_cells.size();
+    m_point_cells.emplace_back();
+    if (spline < last)
+    {
+        RenumberSpline(spline, last);
+        std::swap(m_point_cells[spline], m_point_cells[last]);
+    }
+
+    std::vector<uint64_t>& cells = m_point_cells[spline];
+    cells.resize(points.size());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        cells[i] = CellKey(points[i]);
+        Insert(cells[i], { static_cast<uint32_t>(spline), static_cast<uint32_t>(i) }, points[i]);
+    }
+}
+
+void SpatialHash2d::RemoveSpline(size_t spline)
+{
+    assert(spline < m_point_cells.size());
+
+    const std::vector<uint64_t>& cells = m_point_cells[spline];
+    for (size_t i = 0; i < cells.size(); ++i)
+    {
+        Erase(cells[i], { static_cast<uint32_t>(spline), static_cast<uint32_t>(i) });
+    }
+
+    // The last spline fills the gap.
+    const size_t last = m_point_cells.size() - 1;
+    if (spline < last)
+    {
+        RenumberSpline(last, spline);
+        m_point_cells[spline] = std::move(m_point_cells[last]);
+    }
+    m_point_cells.pop_back();
+}
+
+void SpatialHash2d::UpdateSpline
+(
+    size_t spline,
+    std::span<const glm::vec2> points
+)
+{
+    assert(spline < m_point_cells.size());
+
+    std::vector<uint64_t>& cells = m_point_cells[spline];
+    while (cells.size() > points.size())
+    {
+        Erase(cells.back(), { static_cast<uint32_t>(spline), static_cast<uint32_t>(cells.size() - 1) });
+        cells.pop_back();
+    }
+
+    const size_t nb_moved = cells.size();
+    for (size_t i = 0; i < nb_moved; ++i)
+    {
+        MovePoint(spline, i, points[i]);
+    }
+
+    for (size_t i = nb_moved; i < points.size(); ++i)
+    {
+        const uint64_t cell = CellKey(points[i]);
+        cells.push_back(cell);
+        Insert(cell, { static_cast<uint32_t>(spline), static_cast<uint32_t>(i) }, points[i]);
+    }
+}
+
+void SpatialHash2d::MovePoint
+(
+    size_t spline,
+    size_t point,
+    const glm::vec2& position
+)
+{
+    const Item item = { static_cast<uint32_t>(spline), static_cast<uint32_t>(point) };
+    uint64_t& cell = m_point_cells[spline][point];
+    const uint64_t new_cell = CellKey(position);
+    if (new_cell == cell)
+    {
+        Find(cell, item).position = position;
+        return;
+    }
+
+    Erase(cell, item);
+    Insert(new_cell, item, position);
+    cell = new_cell;
+}
+
+std::optional<SpatialHash2d::Item> SpatialHash2d::FindNearest
+(
+    const glm::vec2& position,
+    float radius
+) const
+{
+    const auto x_min = static_cast<int32_t>(std::floor((position.x - radius) / m_cell_size));
+    const auto x_max = static_cast<int32_t>(std::floor((position.x + radius) / m_cell_size));
+    const auto y_min = static_cast<int32_t>(std::floor((position.y - radius) / m_cell_size));
+    const auto y_max = static_cast<int32_t>(std::floor((position.y + radius) / m_cell_size));
+
+    std::optional<Item> nearest;
+    float nearest_distance2 = radius * radius;
+    for (int32_t x = x_min; x <= x_max; ++x)
+    {
+        for (int32_t y = y_min; y <= y_max; ++y)
+        {
+            auto it = m_cells.find(CellKey(x, y));
+            if (it == m_cells.end())
+            {
+                continue;
+            }
+
+            for (const auto& e : it->second)
+            {
+                const glm::vec2 d = e.position - position;
+                const float distance2 = glm::dot(d, d);
+                const bool is_first = nearest && distance2 == nearest_distance2
+                    && (e.item.spline < nearest->spline || (e.item.spline == nearest->spline && e.item.point < nearest->point));
+                if (distance2 < nearest_distance2 || is_first)
+                {
+                    nearest = e.item;
+                    nearest_distance2 = distance2;
+                }
+            }
+        }
+    }
+
+    return nearest;
+}
+
+size_t SpatialHash2d::GetNbPoints() const
+{
+    size_t nb_points = 0;
+    for (const auto& cells : m_point_cells)
+    {
+        nb_points += cells.size();
+    }
+    return nb_points;
+}
+
+float SpatialHash2d::GetCellSize() const
+{
+    return m_cell_size;
+}
+
+uint64_t SpatialHash2d::CellKey(const glm::vec2& position) const
+{
+    return CellKey(static_cast<int32_t>(std::floor(position.x / m_cell_size)), static_cast<int32_t>(std::floor(position.y / m_cell_size)));
+}
+
+uint64_t SpatialHash2d::CellKey(int32_t x, int32_t y)
+{
+    // Mixed so that neighbouring cells spread over the buckets.
+    uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+    return key;
+}
+
+void SpatialHash2d::Insert
+(
+    uint64_t cell,
+    const Item& item,
+    const glm::vec2& position
+)
+{
+    m_cells[cell].push_back({ item, position });
+}
+
+void SpatialHash2d::Erase
+(
+    uint64_t cell,
+    const Item& item
+)
+{
+    std::vector<entry>& entries = m_cells.find(cell)->second;
+    entry& e = Find(cell, item);
+    e = entries.back();
+    entries.pop_back();
+
+    // The cell is kept even when emptied, so that dragging a point back into it does not allocate.
+}
+
+void SpatialHash2d::RenumberSpline
+(
+    size_t from,
+    size_t to
+)
+{
+    const std::vector<uint64_t>& cells = m_point_cells[from];
+    for (size_t i = 0; i < cells.size(); ++i)
+    {
+        Find(cells[i], { static_cast<uint32_t>(from), static_cast<uint32_t>(i) }).item.spline = static_cast<uint32_t>(to);
+    }
+}
+
+SpatialHash2d::entry& SpatialHash2d::Find
+(
+    uint64_t cell,
+    const Item& item
+)
+{
+    std::vector<entry>& entries = m_cells.find(cell)->second;
+    auto it = std::ranges::find_if(entries, [&](const entry& e) { return e.item.spline == item.spline && e.item.point == item.point; });
+    assert(it != entries.end());
+    return *it;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+// Uniform grid over the control points of every spline, stored sparsely in a hash map of cells.
+// Points are kept in the cell of their position and moved incrementally, so that a query within
+// a radius of about the cell size only visits a few cells. Cells stay in the map once emptied.
+class SpatialHash2d
+{
+public:
+    struct Item
+    {
+        uint32_t spline;
+        uint32_t point;
+    };
+
+    explicit SpatialHash2d(float cell_size = 32.f);
+
+    void Clear();
+
+    // Splines are numbered as in the scene. InsertSpline moves the spline in its way to the end and
+    // RemoveSpline moves the last one in its place, each in the time of the points involved.
+    void InsertSpline(size_t spline, std::span<const glm::vec2> points);
+    void RemoveSpline(size_t spline);
+
+    // Catches up with any edit of the points of a spline, including a change of their count.
+    void UpdateSpline(size_t spline, std::span<const glm::vec2> points);
+    void MovePoint(size_t spline, size_t point, const glm::vec2& position);
+
+    // Closest point strictly within radius of position, the first spline and point on ties.
+    std::optional<Item> FindNearest(const glm::vec2& position, float radius) const;
+
+    size_t GetNbPoints() const;
+    float GetCellSize() const;
+
+private:
+    // Positions are copied next to the items, queries do not have to look into the splines.
+    struct entry
+    {
+        Item item;
+        glm::vec2 position;
+    };
+
+    uint64_t CellKey(const glm::vec2& position) const;
+    static uint64_t CellKey(int32_t x, int32_t y);
+
+    void Insert(uint64_t cell, const Item& item, const glm::vec2& position);
+    void Erase(uint64_t cell, const Item& item);
+    entry& Find(uint64_t cell, const Item& item);
+    void RenumberSpline(size_t from, size_t to);
+
+    float m_cell_size;
+    std::unordered_map<uint64_t, std::vector<entry>> m_cells;
+    std::vector<std::vector<uint64_t>> m_point_cells;     // Cell of every point, per spline.
+};
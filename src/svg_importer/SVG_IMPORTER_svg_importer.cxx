@@ -0,0 +1,474 @@
+#include "../svg_importer/svg_importer.h"
+#include "../bezier/bezier.h"
+
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    constexpr size_t buffer_size = 1 << 16;
+
+    // Longest token read in one piece : attribute names and numbers.
+    constexpr size_t max_token_size = 256;
+
+    // Window over the input : bytes are read in blocks, the unread tail is moved to the front
+    // when a token could cross the end of the buffer.
+    class input_buffer
+    {
+    public:
+        explicit input_buffer(std::istream& in)
+            : m_in(in)
+            , m_buffer(buffer_size)
+        {
+        }
+
+        // At least n bytes from the cursor, or what is left before the end of the input.
+        size_t Available(size_t n)
+        {
+            while (m_end - m_position < n && !m_is_at_eof)
+            {
+                Refill();
+            }
+            return m_end - m_position;
+        }
+
+        const char* Current() const { return m_buffer.data() + m_position; }
+        char Peek() { return Available(1) > 0 ? m_buffer[m_position] : '\0'; }
+        void Advance(size_t n) { m_position += n; }
+        size_t GetNbBytes() const { return m_nb_bytes; }
+
+        // Moves to the next occurrence of c, or to the end of the input. Returns whether c was found.
+        bool SkipTo(char c)
+        {
+            while (Available(1) > 0)
+            {
+                const auto* found = static_cast<const char*>(std::memchr(Current(), c, m_end - m_position));
+                if (found)
+                {
+                    m_position = static_cast<size_t>(found - m_buffer.data());
+                    return true;
+                }
+                m_position = m_end;
+            }
+            return false;
+        }
+
+    private:
+        void Refill()
+        {
+            std::memmove(m_buffer.data(), Current(), m_end - m_position);
+            m_end -= m_position;
+            m_position = 0;
+
+            m_in.read(m_buffer.data() + m_end, static_cast<std::streamsize>(m_buffer.size() - m_end));
+            const auto nb_read = static_cast<size_t>(m_in.gcount());
+            m_end += nb_read;
+            m_nb_bytes += nb_read;
+            m_is_at_eof = nb_read == 0;
+        }
+
+        std::istream& m_in;
+        std::vector<char> m_buffer;
+        size_t m_position = 0;
+        size_t m_end = 0;
+        size_t m_nb_bytes = 0;
+        bool m_is_at_eof = false;
+    };
+
+    bool is_space(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    bool is_number_start(char c)
+    {
+        return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.';
+    }
+
+    // Path data of one d attribute, up to the closing quote. Every subpath is sent to the sink
+    // as soon as it ends, only its own points are kept.
+    class path_data_parser
+    {
+    public:
+        path_data_parser(input_buffer& input, char quote, const SvgImporter::subpath_sink& sink, SvgImporter::statistics& statistics)
+            : m_input(input)
+            , m_quote(quote)
+            , m_sink(sink)
+            , m_statistics(statistics)
+        {
+        }
+
+        void Parse(std::vector<glm::vec2>& points)
+        {
+            m_points = &points;
+            m_points->clear();
+
+            char command = '\0';
+            while (true)
+            {
+                SkipSeparators();
+                const char c = m_input.Peek();
+                if (c == m_quote || c == '\0')
+                {
+                    break;
+                }
+
+                // Arguments without a command letter repeat the previous command, a moveto is followed by linetos.
+                if (!is_number_start(c))
+                {
+                    command = c;
+                    m_input.Advance(1);
+                }
+                else if (command == 'M' || command == 'm')
+                {
+                    command = command == 'M' ? 'L' : 'l';
+                }
+                else if (command == '\0' || command == 'Z' || command == 'z')
+                {
+                    ++m_statistics.nb_errors;
+                    break;
+                }
+
+                if (!ParseCommand(command))
+                {
+                    ++m_statistics.nb_errors;
+                    break;
+                }
+            }
+
+            EndSubpath();
+            m_input.SkipTo(m_quote);
+        }
+
+    private:
+        bool ParseCommand(char command)
+        {
+            const bool is_relative = command >= 'a' && command <= 'z';
+            const glm::vec2 origin = is_relative ? m_current : glm::vec2(0.f);
+
+            switch (command)
+            {
+            case 'M': case 'm':
+            {
+                glm::vec2 p;
+                if (!ReadPoint(p)) { return false; }
+                EndSubpath();
+                m_current = m_subpath_start = origin + p;
+                m_last_control = m_current;
+            } break;
+            case 'L': case 'l':
+            {
+                glm::vec2 p;
+                if (!ReadPoint(p)) { return false; }
+                AddLine(origin + p);
+            } break;
+            case 'H': case 'h':
+            {
+                float x;
+                if (!ReadNumber(x)) { return false; }
+                AddLine(glm::vec2(origin.x + x, m_current.y));
+            } break;
+            case 'V': case 'v':
+            {
+                float y;
+                if (!ReadNumber(y)) { return false; }
+                AddLine(glm::vec2(m_current.x, origin.y + y));
+            } break;
+            case 'C': case 'c':
+            {
+                glm::vec2 p1, p2, p3;
+                if (!ReadPoint(p1) || !ReadPoint(p2) || !ReadPoint(p3)) { return false; }
+                AddCubic(origin + p1, origin + p2, origin + p3);
+            } break;
+            case 'S': case 's':
+            {
+                // The first control point reflects the second one of the previous cubic.
+                glm::vec2 p2, p3;
+                if (!ReadPoint(p2) || !ReadPoint(p3)) { return false; }
+                const glm::vec2 p1 = IsPrevious("CcSs") ? 2.f * m_current - m_last_control : m_current;
+                AddCubic(p1, origin + p2, origin + p3);
+            } break;
+            case 'Q': case 'q':
+            {
+                glm::vec2 q1, q2;
+                if (!ReadPoint(q1) || !ReadPoint(q2)) { return false; }
+                AddQuadratic(origin + q1, origin + q2);
+            } break;
+            case 'T': case 't':
+            {
+                glm::vec2 q2;
+                if (!ReadPoint(q2)) { return false; }
+                const glm::vec2 q1 = IsPrevious("QqTt") ? 2.f * m_current - m_last_control : m_current;
+                AddQuadratic(q1, origin + q2);
+            } break;
+            case 'A': case 'a':
+            {
+                float rx, ry, rotation;
+                char large_arc, sweep;
+                glm::vec2 p;
+                if (!ReadNumber(rx) || !ReadNumber(ry) || !ReadNumber(rotation) || !ReadFlag(large_arc) || !ReadFlag(sweep) || !ReadPoint(p)) { return false; }
+                AddLine(origin + p);
+            } break;
+            case 'Z': case 'z':
+            {
+                if (m_current != m_subpath_start)
+                {
+                    AddLine(m_subpath_start);
+                }
+                EndSubpath();
+                m_current = m_last_control = m_subpath_start;
+            } break;
+            default: return false;
+            }
+
+            m_previous_command = command;
+            return true;
+        }
+
+        bool IsPrevious(std::string_view commands) const
+        {
+            return commands.find(m_previous_command) != std::string_view::npos;
+        }
+
+        void AddCubic(const glm::vec2& p1, const glm::vec2& p2, const glm::vec2& p3)
+        {
+            m_points->insert(m_points->end(), { m_current, p1, p2, p3 });
+            m_last_control = p2;
+            m_current = p3;
+            ++m_statistics.nb_curves;
+        }
+
+        void AddQuadratic(const glm::vec2& q1, const glm::vec2& q2)
+        {
+            const auto cubic = Bezier<2, 2, float>({ m_current, q1, q2 }).Elevate();
+            AddCubic(cubic.P[1], cubic.P[2], cubic.P[3]);
+            m_last_control = q1;
+        }
+
+        void AddLine(const glm::vec2& p)
+        {
+            const auto cubic = Bezier<1, 2, float>({ m_current, p }).Elevate().Elevate();
+            AddCubic(cubic.P[1], cubic.P[2], cubic.P[3]);
+            m_last_control = p;
+        }
+
+        void EndSubpath()
+        {
+            if (!m_points->empty())
+            {
+                m_sink(*m_points);
+                m_points->clear();
+                ++m_statistics.nb_subpaths;
+            }
+        }
+
+        void SkipSeparators()
+        {
+            for (char c = m_input.Peek(); is_space(c) || c == ','; c = m_input.Peek())
+            {
+                m_input.Advance(1);
+            }
+        }
+
+        bool ReadNumber(float& value)
+        {
+            SkipSeparators();
+            const size_t available = m_input.Available(max_token_size);
+            const char* end = SvgImporter::ReadFloat(m_input.Current(), m_input.Current() + available, value);
+            if (!end)
+            {
+                return false;
+            }
+            m_input.Advance(static_cast<size_t>(end - m_input.Current()));
+            return true;
+        }
+
+        bool ReadPoint(glm::vec2& p)
+        {
+            return ReadNumber(p.x) && ReadNumber(p.y);
+        }
+
+        // Arc flags are single digits, possibly not separated from what follows.
+        bool ReadFlag(char& flag)
+        {
+            SkipSeparators();
+            flag = m_input.Peek();
+            m_input.Advance(flag == '0' || flag == '1' ? 1 : 0);
+            return flag == '0' || flag == '1';
+        }
+
+        input_buffer& m_input;
+        char m_quote;
+        const SvgImporter::subpath_sink& m_sink;
+        SvgImporter::statistics& m_statistics;
+        std::vector<glm::vec2>* m_points = nullptr;
+
+        glm::vec2 m_current = glm::vec2(0.f);
+        glm::vec2 m_subpath_start = glm::vec2(0.f);
+        glm::vec2 m_last_control = glm::vec2(0.f);
+        char m_previous_command = '\0';
+    };
+
+    bool starts_with(input_buffer& input, std::string_view prefix)
+    {
+        return input.Available(prefix.size()) >= prefix.size() && std::memcmp(input.Current(), prefix.data(), prefix.size()) == 0;
+    }
+
+    // Attributes of a path tag, from after its name to the end of the tag.
+    void parse_path_attributes(input_buffer& input, const SvgImporter::subpath_sink& sink, SvgImporter::statistics& statistics, std::vector<glm::vec2>& points)
+    {
+        while (true)
+        {
+            for (char c = input.Peek(); is_space(c); c = input.Peek())
+            {
+                input.Advance(1);
+            }
+            const char c = input.Peek();
+            if (c == '\0' || c == '>' || c == '/')
+            {
+                return;
+            }
+
+            // Name, then = and a quoted value.
+            const size_t available = input.Available(max_token_size);
+            const char* name = input.Current();
+            size_t name_size = 0;
+            while (name_size < available && name[name_size] != '=' && name[name_size] != '>' && !is_space(name[name_size]))
+            {
+                ++name_size;
+            }
+            const bool is_d = name_size == 1 && name[0] == 'd';
+            input.Advance(name_size);
+
+            for (char s = input.Peek(); is_space(s); s = input.Peek())
+            {
+                input.Advance(1);
+            }
+            if (input.Peek() != '=')
+            {
+                continue;
+            }
+            input.Advance(1);
+            for (char s = input.Peek(); is_space(s); s = input.Peek())
+            {
+                input.Advance(1);
+            }
+
+            const char quote = input.Peek();
+            if (quote != '"' && quote != '\'')
+            {
+                continue;
+            }
+            input.Advance(1);
+
+            if (is_d)
+            {
+                path_data_parser(input, quote, sink, statistics).Parse(points);
+            }
+            else
+            {
+                input.SkipTo(quote);
+            }
+            input.Advance(input.Available(1) > 0 ? 1 : 0);
+        }
+    }
+}
+
+const char* SvgImporter::ReadFloat(const char* first, const char* last, float& value)
+{
+    constexpr std::array<float, 11> powers_of_ten = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+    const char* p = first;
+    const bool is_negative = p < last && *p == '-';
+    p += p < last && (*p == '-' || *p == '+') ? 1 : 0;
+    const char* digits = p;
+
+    uint64_t mantissa = 0;
+    size_t nb_decimals = 0;
+    for (; p < last && static_cast<unsigned char>(*p - '0') < 10; ++p)
+    {
+        mantissa = 10 * mantissa + static_cast<uint64_t>(*p - '0');
+    }
+    const size_t nb_integer_digits = static_cast<size_t>(p - digits);
+    if (p < last && *p == '.')
+    {
+        for (++p; p < last && static_cast<unsigned char>(*p - '0') < 10; ++p)
+        {
+            mantissa = 10 * mantissa + static_cast<uint64_t>(*p - '0');
+            ++nb_decimals;
+        }
+    }
+
+    const bool has_exponent = p < last && (*p == 'e' || *p == 'E');
+    const bool is_fast = nb_integer_digits + nb_decimals <= 19 && mantissa <= (1u << 24) && nb_decimals < powers_of_ten.size() && !has_exponent;
+    if (nb_integer_digits + nb_decimals == 0)
+    {
+        return nullptr;
+    }
+    if (!is_fast)
+    {
+        // from_chars takes no plus sign.
+        const auto [end, error] = std::from_chars(first < last && *first == '+' ? first + 1 : first, last, value);
+        return error == std::errc() ? end : nullptr;
+    }
+
+    value = static_cast<float>(mantissa) / powers_of_ten[nb_decimals];
+    value = is_negative ? -value : value;
+    return p;
+}
+
+SvgImporter::statistics SvgImporter::Parse(std::istream& in, const subpath_sink& sink)
+{
+    statistics statistics;
+    input_buffer input(in);
+    std::vector<glm::vec2> points;
+
+    while (input.SkipTo('<'))
+    {
+        input.Advance(1);
+        if (starts_with(input, "!--"))
+        {
+            // Comments may contain anything, tags included.
+            while (input.SkipTo('-') && !starts_with(input, "-->"))
+            {
+                input.Advance(1);
+            }
+            continue;
+        }
+        if (starts_with(input, "path") && input.Available(5) >= 5 && (is_space(input.Current()[4]) || input.Current()[4] == '/' || input.Current()[4] == '>'))
+        {
+            input.Advance(4);
+            ++statistics.nb_paths;
+            parse_path_attributes(input, sink, statistics, points);
+        }
+    }
+
+    statistics.nb_bytes = input.GetNbBytes();
+    return statistics;
+}
+
+SvgImporter::statistics SvgImporter::Import(std::istream& in, data& data)
+{
+    std::vector<glm::vec2> spline_points;
+    return Parse(in, [&](std::span<const glm::vec2> points)
+        {
+            spline_points.assign(points.begin(), points.end());
+            data.add_spline(spline_points, spline_type::BEZIER);
+        });
+}
+
+std::optional<SvgImporter::statistics> SvgImporter::ImportFile(const char* path, data& data)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return std::nullopt;
+    }
+    return Import(file, data);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <optional>
+#include <span>
+
+#include "../scene/scene.h"
+
+// Streaming reader of the path elements of SVG files. The input goes once through a fixed size
+// buffer, tags are scanned for their d attribute and the path data is tokenized in place : no
+// document is built, and memory does not grow with the size of the file.
+namespace SvgImporter
+{
+    struct statistics
+    {
+        size_t nb_bytes = 0;
+        size_t nb_paths = 0;
+        size_t nb_subpaths = 0;
+        size_t nb_curves = 0;
+        size_t nb_errors = 0;       // Path data stopped at a syntax error, the curves before it are kept.
+    };
+
+    // Receives the control points of every subpath, 4 per cubic as CubicBezierSpline2d takes them.
+    using subpath_sink = std::function<void(std::span<const glm::vec2>)>;
+
+    // Number of the path data at first, as std::from_chars reads it but for a leading plus sign.
+    // Plain decimals of up to 7 significant digits and 10 decimals take Clinger's fast path : the
+    // digits and the power of ten are exact floats, so the one division rounds as from_chars does.
+    // Returns the end of the number, or nullptr.
+    const char* ReadFloat(const char* first, const char* last, float& value);
+
+    // Lines and quadratics are elevated to cubics, arcs are replaced by a line to their end point.
+    // Transforms and styles are ignored.
+    statistics Parse(std::istream& in, const subpath_sink& sink);
+
+    // Adds every subpath to the scene as a Bezier spline.
+    statistics Import(std::istream& in, data& data);
+    std::optional<statistics> ImportFile(const char* path, data& data);
+};
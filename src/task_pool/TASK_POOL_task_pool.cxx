@@ -0,0 +1,191 @@
+#include "../task_pool/task_pool.h"
+
+#include <cassert>
+
+namespace
+{
+    // Queue of the current thread when it is a worker of pool.
+    thread_local const TaskPool* worker_pool = nullptr;
+    thread_local size_t worker_queue_index = 0;
+}
+
+TaskPool::TaskPool(size_t nb_workers)
+{
+    for (size_t i = 0; i <= nb_workers; ++i)
+    {
+        m_queues.push_back(std::make_unique<queue>());
+    }
+
+    m_workers.reserve(nb_workers);
+    for (size_t i = 0; i < nb_workers; ++i)
+    {
+        m_workers.emplace_back([this, i]() { WorkerLoop(i); });
+    }
+}
+
+TaskPool::~TaskPool()
+{
+    {
+        std::lock_guard lock(m_sleep_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+
+    for (std::thread& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+size_t TaskPool::DefaultNbWorkers()
+{
+    const unsigned int nb_cores = std::thread::hardware_concurrency();
+    return nb_cores > 1 ? nb_cores - 1 : 0;
+}
+
+size_t TaskPool::GetNbThreads() const
+{
+    return m_workers.size() + 1;
+}
+
+void TaskPool::ParallelFor
+(
+    size_t count,
+    size_t grain,
+    const std::function<void(size_t, size_t)>& function
+)
+{
+    assert(grain > 0);
+    if (count == 0)
+    {
+        return;
+    }
+    if (count <= grain || m_workers.empty())
+    {
+        function(0, count);
+        return;
+    }
+
+    loop l{ &function, grain, count };
+    const size_t queue_index = GetQueueIndex();
+    Run(queue_index, task{ &l, 0, count });
+
+    // The ranges left are either queued or running, the thread helps with any of them until the
+    // last one is done, possibly with tasks of other loops.
+    while (l.remaining.load(std::memory_order_acquire) > 0)
+    {
+        task t;
+        if (Pop(queue_index, t) || Steal(queue_index, t))
+        {
+            Run(queue_index, t);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void TaskPool::WorkerLoop(size_t queue_index)
+{
+    worker_pool = this;
+    worker_queue_index = queue_index;
+
+    while (true)
+    {
+        task t;
+        if (Pop(queue_index, t) || Steal(queue_index, t))
+        {
+            Run(queue_index, t);
+            continue;
+        }
+
+        std::unique_lock lock(m_sleep_mutex);
+        m_wake.wait(lock, [this]() { return m_stop || m_nb_queued.load(std::memory_order_acquire) > 0; });
+        if (m_stop)
+        {
+            return;
+        }
+    }
+}
+
+size_t TaskPool::GetQueueIndex() const
+{
+    return worker_pool == this ? worker_queue_index : m_queues.size() - 1;
+}
+
+void TaskPool::Push
+(
+    size_t queue_index,
+    const task& t
+)
+{
+    {
+        std::lock_guard lock(m_queues[queue_index]->mutex);
+        m_queues[queue_index]->tasks.push_back(t);
+    }
+    m_nb_queued.fetch_add(1, std::memory_order_release);
+
+    // Taking the lock orders the push before the check of a worker about to sleep.
+    {
+        std::lock_guard lock(m_sleep_mutex);
+    }
+    m_wake.notify_one();
+}
+
+bool TaskPool::Pop
+(
+    size_t queue_index,
+    task& t
+)
+{
+    queue& q = *m_queues[queue_index];
+    std::lock_guard lock(q.mutex);
+    if (q.tasks.empty())
+    {
+        return false;
+    }
+    t = q.tasks.back();
+    q.tasks.pop_back();
+    m_nb_queued.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool TaskPool::Steal
+(
+    size_t queue_index,
+    task& t
+)
+{
+    for (size_t i = 1; i < m_queues.size(); ++i)
+    {
+        queue& q = *m_queues[(queue_index + i) % m_queues.size()];
+        std::lock_guard lock(q.mutex);
+        if (!q.tasks.empty())
+        {
+            t = q.tasks.front();
+            q.tasks.pop_front();
+            m_nb_queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskPool::Run
+(
+    size_t queue_index,
+    task t
+)
+{
+    // Halves are left to thieves until the range fits in a grain.
+    while (t.end - t.begin > t.parent->grain)
+    {
+        const size_t middle = t.begin + (t.end - t.begin) / 2;
+        Push(queue_index, task{ t.parent, middle, t.end });
+        t.end = middle;
+    }
+
+    (*t.parent->function)(t.begin, t.end);
+    t.parent->remaining.fetch_sub(t.end - t.begin, std::memory_order_acq_rel);
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing pool of worker threads for data parallel loops. Every thread owns a queue of index
+// ranges : it splits the range it takes in halves, keeps working on the first and pushes the second
+// on the back of its queue, where it takes its next range from. Idle threads steal from the front of
+// the other queues, so they take the largest ranges left and the loop balances itself.
+class TaskPool
+{
+public:
+    // The calling thread works as well, nb_workers threads are started beside it.
+    explicit TaskPool(size_t nb_workers = DefaultNbWorkers());
+    ~TaskPool();
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    static size_t DefaultNbWorkers();
+
+    // Calls function(begin, end) on ranges of at most grain indices covering [0, count) and returns
+    // once they are all done. May be called from a task, the waiting thread runs tasks meanwhile.
+    void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& function);
+
+    // Worker threads and the calling thread.
+    size_t GetNbThreads() const;
+
+private:
+    struct loop
+    {
+        const std::function<void(size_t, size_t)>* function;
+        size_t grain;
+        std::atomic<size_t> remaining;      // Indices not done yet.
+    };
+
+    struct task
+    {
+        loop* parent;
+        size_t begin;
+        size_t end;
+    };
+
+    struct queue
+    {
+        std::mutex mutex;
+        std::deque<task> tasks;
+    };
+
+    void WorkerLoop(size_t queue_index);
+    size_t GetQueueIndex() const;
+
+    void Push(size_t queue_index, const task& t);
+    bool Pop(size_t queue_index, task& t);
+    bool Steal(size_t queue_index, task& t);
+    void Run(size_t queue_index, task t);
+
+    // One queue per worker, and the last one for any thread outside of the pool.
+    std::vector<std::unique_ptr<queue>> m_queues;
+    std::vector<std::thread> m_workers;
+
+    std::atomic<size_t> m_nb_queued = 0;
+    std::mutex m_sleep_mutex;
+    std::condition_variable m_wake;
+    bool m_stop = false;
+};
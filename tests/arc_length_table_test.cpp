@@ -0,0 +1,125 @@
+// Arc length tables against the length of a dense polyline through the spline : t(s) lookups,
+// and the equal chord spacing of Discretization::ArcLength.
+
+#include "../src/arc_length_table/arc_length_table.h"
+#include "../src/discretization/discretization.h"
+#include "../src/scene_generator/scene_generator.h"
+#include "check.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr size_t nb_dense_samples = 100001;
+
+    // Cumulative length of the polyline through nb_dense_samples uniform samples, and s(t) interpolated in it.
+    struct dense_lengths
+    {
+        std::vector<double> lengths;
+
+        template <class Spline>
+        explicit dense_lengths(const Spline& spline)
+        {
+            std::vector<double> t(nb_dense_samples);
+            for (size_t i = 0; i < t.size(); ++i)
+            {
+                t[i] = static_cast<double>(i) / static_cast<double>(nb_dense_samples - 1);
+            }
+            std::vector<glm::vec2> pts(nb_dense_samples);
+            spline.Eval(t, pts);
+
+            lengths.resize(nb_dense_samples);
+            lengths[0] = 0.0;
+            for (size_t i = 1; i < pts.size(); ++i)
+            {
+                lengths[i] = lengths[i - 1] + glm::length(glm::dvec2(pts[i]) - glm::dvec2(pts[i - 1]));
+            }
+        }
+
+        double GetArcLength(double t) const
+        {
+            const double x = std::clamp(t, 0.0, 1.0) * static_cast<double>(nb_dense_samples - 1);
+            const auto i = std::min(static_cast<size_t>(x), nb_dense_samples - 2);
+            return lengths[i] + (x - static_cast<double>(i)) * (lengths[i + 1] - lengths[i]);
+        }
+    };
+
+    // Each curve starts where the previous one ends, for Bezier and Hermite splines alike, so that
+    // the dense polyline does not jump between them.
+    std::vector<glm::vec2> JoinCurves(std::vector<glm::vec2> points)
+    {
+        for (size_t i = 4; i < points.size(); i += 4)
+        {
+            points[i] = points[i - 1];
+        }
+        return points;
+    }
+
+    template <class Spline>
+    void TestTable(std::mt19937& generator, const ArcLengthTable<Spline>& table)
+    {
+        const dense_lengths reference(table.m_spline);
+        const double length = reference.lengths.back();
+        // The dense polyline is shorter than the curve by about the square of its step.
+        const double tolerance = 1e-4 * length;
+
+        SPLINE_CHECK(std::abs(table.GetLength() - length) <= tolerance);
+
+        // t(s) by binary search and Newton's method, one at a time and batched in order.
+        std::uniform_real_distribution<double> distribution(0.0, length);
+        std::vector<double> s(256);
+        for (double& si : s)
+        {
+            si = distribution(generator);
+        }
+        std::ranges::sort(s);
+        std::vector<double> t(s.size());
+        table.GetParameters(s, t);
+        for (size_t i = 0; i < s.size(); ++i)
+        {
+            const double ti = table.GetParameter(s[i]);
+            SPLINE_CHECK(std::abs(reference.GetArcLength(ti) - s[i]) <= tolerance);
+            SPLINE_CHECK(std::abs(table.GetArcLength(ti) - s[i]) <= 1e-6 * length);
+            SPLINE_CHECK(std::abs(t[i] - ti) <= 1e-9);
+        }
+        SPLINE_CHECK(table.GetParameter(0.0) == 0.0);
+        SPLINE_CHECK(std::abs(table.GetParameter(table.GetLength()) - 1.0) <= 1e-12);
+
+        // Consecutive samples are an equal arc length apart, their chords within the sag of the curve
+        // once the samples are close enough for the arcs between them to be nearly straight.
+        for (uint32_t nb_pts : { 10u, 100u, 200u })
+        {
+            const std::vector<glm::vec2> pts = Discretization::ArcLength(table, nb_pts);
+            const double step = length / static_cast<double>(nb_pts - 1);
+            for (size_t i = 1; i < pts.size(); ++i)
+            {
+                const double chord = glm::length(glm::dvec2(pts[i]) - glm::dvec2(pts[i - 1]));
+                SPLINE_CHECK(chord <= step + tolerance && chord >= 0.9 * step);
+            }
+            SPLINE_CHECK(glm::length(pts.front() - table.m_spline.Eval(0.0)) <= 1e-3f);
+            SPLINE_CHECK(glm::length(pts.back() - table.m_spline.Eval(1.0)) <= 1e-3f);
+        }
+    }
+}
+
+int main()
+{
+    std::mt19937 generator(1);
+    for (size_t nb_ctrl_pts : { 4, 16, 64 })
+    {
+        const std::vector<glm::vec2> points = SceneGenerator::RandomControlPoints(static_cast<uint32_t>(nb_ctrl_pts), nb_ctrl_pts);
+        const std::vector<glm::vec2> joined = JoinCurves(points);
+        TestTable(generator, ArcLengthTable<CubicBezierSpline2d>(CubicBezierSpline2d(joined)));
+        TestTable(generator, ArcLengthTable<CubicHermiteSpline2d>(CubicHermiteSpline2d(joined)));
+        TestTable(generator, ArcLengthTable<CubicBSpline2d>(CubicBSpline2d(points)));
+
+        // Built from a temporary, the table keeps the spline alive.
+        const ArcLengthTable<CubicBezierSpline2d> converted(CubicBezierSpline2d::FromCubicBSpline2d(CubicBSpline2d(points)), 8);
+        TestTable(generator, converted);
+    }
+
+    return Check::Result();
+}
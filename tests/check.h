@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+
+// Checks of the headless tests. A failed check is reported and the test goes on, main returns
+// Check::Result() so that ctest sees the failures.
+namespace Check
+{
+    inline int nb_failures = 0;
+
+    inline int Result()
+    {
+        if (nb_failures > 0)
+        {
+            std::fprintf(stderr, "%d checks failed\n", nb_failures);
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+};
+
+#define SPLINE_CHECK(condition)                                                                     \
+    do                                                                                              \
+    {                                                                                               \
+        if (!(condition))                                                                           \
+        {                                                                                           \
+            std::fprintf(stderr, "%s:%d: check failed : %s\n", __FILE__, __LINE__, #condition);     \
+            ++Check::nb_failures;                                                                   \
+        }                                                                                           \
+    } while (false)
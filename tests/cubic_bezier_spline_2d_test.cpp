@@ -0,0 +1,120 @@
+// Bezier form of CubicBSpline2d against its knot span evaluation, on clamped uniform, non-uniform,
+// repeated and fitted knots, and on interior knots repeated up to breaking the curve.
+
+#include "../src/cubic_bezier_spline_2d/cubic_bezier_spline_2d.h"
+#include "../src/cubic_bspline_2d/cubic_bspline_2d.h"
+#include "../src/bspline_fit/bspline_fit.h"
+#include "check.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+    std::vector<glm::vec2> RandomPoints(std::mt19937& generator, size_t nb_points)
+    {
+        std::uniform_real_distribution<float> coordinate(-100.f, 100.f);
+        std::vector<glm::vec2> points(nb_points);
+        for (glm::vec2& point : points)
+        {
+            point = glm::vec2(coordinate(generator), coordinate(generator));
+        }
+        return points;
+    }
+
+    // Clamped knots with random interior knots, every other one doubled when asked.
+    std::vector<double> RandomKnots(std::mt19937& generator, size_t nb_ctrl_pts, bool has_double_knots)
+    {
+        std::uniform_real_distribution<double> interior(0.0, 1.0);
+        std::vector<double> knots(nb_ctrl_pts + 4, 0.0);
+        for (size_t i = 4; i < nb_ctrl_pts; ++i)
+        {
+            knots[i] = has_double_knots && i % 2 == 1 ? knots[i - 1] : interior(generator);
+        }
+        std::sort(knots.begin() + 4, knots.begin() + static_cast<std::ptrdiff_t>(nb_ctrl_pts));
+        std::fill(knots.end() - 4, knots.end(), 1.0);
+        return knots;
+    }
+
+    // Clamped uniform knots, the middle interior one repeated multiplicity times.
+    std::vector<double> RepeatedKnots(size_t nb_ctrl_pts, size_t multiplicity)
+    {
+        const size_t nb_interior = nb_ctrl_pts - 4 - (multiplicity - 1);
+        std::vector<double> knots(4, 0.0);
+        for (size_t i = 1; i <= nb_interior; ++i)
+        {
+            const double knot = static_cast<double>(i) / static_cast<double>(nb_interior + 1);
+            knots.insert(knots.end(), i == (nb_interior + 1) / 2 ? multiplicity : 1, knot);
+        }
+        knots.insert(knots.end(), 4, 1.0);
+        return knots;
+    }
+
+    // Curve k of the Bezier form over [0, 1] against the spline over the k-th non-empty knot span,
+    // its end approached from within the span where the curve breaks.
+    void TestSpline(const CubicBSpline2d& spline)
+    {
+        const CubicBezierSpline2d bezier_spline = CubicBezierSpline2d::FromCubicBSpline2d(spline);
+        const std::vector<double>& knots = spline.m_knots;
+
+        size_t curve = 0;
+        for (size_t span = 3; span < spline.m_ctrl_pts.size(); ++span)
+        {
+            const double start = knots[span];
+            const double end = knots[span + 1];
+            if (!(start < end))
+            {
+                continue;
+            }
+
+            SPLINE_CHECK(curve < bezier_spline.m_curves.size());
+            if (curve == bezier_spline.m_curves.size())
+            {
+                return;
+            }
+
+            for (int i = 0; i <= 16; ++i)
+            {
+                const double u = static_cast<double>(i) / 16.0;
+                const glm::vec2 point = bezier_spline.m_curves[curve].Eval(static_cast<float>(u));
+                const glm::vec2 expected = spline.Eval(std::min(start + u * (end - start), std::nextafter(end, start)));
+                SPLINE_CHECK(glm::length(point - expected) <= 1e-3f);
+            }
+            ++curve;
+        }
+        SPLINE_CHECK(curve == bezier_spline.m_curves.size());
+    }
+}
+
+int main()
+{
+    std::mt19937 generator(1);
+    for (size_t nb_ctrl_pts : { 4, 5, 7, 16, 61 })
+    {
+        const std::vector<glm::vec2> points = RandomPoints(generator, nb_ctrl_pts);
+        TestSpline(CubicBSpline2d(points));
+        TestSpline(CubicBSpline2d(points, RandomKnots(generator, nb_ctrl_pts, false)));
+        TestSpline(CubicBSpline2d(points, RandomKnots(generator, nb_ctrl_pts, true)));
+
+        // A triple knot leaves the curve C0, a quadruple one breaks it.
+        if (nb_ctrl_pts >= 8)
+        {
+            for (size_t multiplicity : { 2, 3, 4 })
+            {
+                TestSpline(CubicBSpline2d(points, RepeatedKnots(nb_ctrl_pts, multiplicity)));
+            }
+        }
+
+        // Knots averaged from chord length parameters.
+        const std::optional<CubicBSpline2d> fitted = BSplineFit::Interpolate(points, BSplineFit::Parameterization::CHORD_LENGTH);
+        SPLINE_CHECK(fitted.has_value());
+        if (fitted)
+        {
+            TestSpline(*fitted);
+        }
+    }
+
+    return Check::Result();
+}
@@ -0,0 +1,177 @@
+// Knot span evaluation of CubicBSpline2d against the recursive Cox-de Boor definition of the basis,
+// on clamped uniform and non-uniform knot vectors.
+
+#include "../src/cubic_bspline_2d/cubic_bspline_2d.h"
+#include "check.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // Basis function i of degree deg at u, zero when its support is empty.
+    double N(double u, size_t i, size_t deg, const std::vector<double>& knots)
+    {
+        if (deg == 0)
+        {
+            return knots[i] <= u && u < knots[i + 1] ? 1.0 : 0.0;
+        }
+
+        const double D0 = knots[i + deg] - knots[i];
+        const double D1 = knots[i + deg + 1] - knots[i + 1];
+        const double N0 = D0 > 0.0 ? (u - knots[i]) / D0 * N(u, i, deg - 1, knots) : 0.0;
+        const double N1 = D1 > 0.0 ? (knots[i + deg + 1] - u) / D1 * N(u, i + 1, deg - 1, knots) : 0.0;
+        return N0 + N1;
+    }
+
+    // Derivative of order k of the basis function.
+    double DerivativeOfN(double u, size_t i, size_t deg, size_t k, const std::vector<double>& knots)
+    {
+        if (k == 0)
+        {
+            return N(u, i, deg, knots);
+        }
+
+        const double D0 = knots[i + deg] - knots[i];
+        const double D1 = knots[i + deg + 1] - knots[i + 1];
+        const double N0 = D0 > 0.0 ? DerivativeOfN(u, i, deg - 1, k - 1, knots) / D0 : 0.0;
+        const double N1 = D1 > 0.0 ? DerivativeOfN(u, i + 1, deg - 1, k - 1, knots) / D1 : 0.0;
+        return static_cast<double>(deg) * (N0 - N1);
+    }
+
+    // Derivative of order k of the curve, and the sum of the magnitudes of its terms to scale the tolerance.
+    glm::dvec2 Reference(const CubicBSpline2d& spline, double u, size_t k, double& magnitude)
+    {
+        glm::dvec2 point(0.0);
+        magnitude = 0.0;
+        for (size_t i = 0; i < spline.m_ctrl_pts.size(); ++i)
+        {
+            const double basis = DerivativeOfN(u, i, 3, k, spline.m_knots);
+            point += basis * glm::dvec2(spline.m_ctrl_pts[i]);
+            magnitude += std::abs(basis) * glm::length(glm::dvec2(spline.m_ctrl_pts[i]));
+        }
+        return point;
+    }
+
+    bool IsClose(const glm::vec2& value, const glm::dvec2& reference, double magnitude)
+    {
+        return glm::length(glm::dvec2(value) - reference) <= 1e-4 * (1.0 + magnitude);
+    }
+
+    std::vector<glm::vec2> RandomPoints(std::mt19937& generator, size_t nb_points)
+    {
+        std::uniform_real_distribution<float> coordinate(-100.f, 100.f);
+        std::vector<glm::vec2> points(nb_points);
+        for (glm::vec2& point : points)
+        {
+            point = glm::vec2(coordinate(generator), coordinate(generator));
+        }
+        return points;
+    }
+
+    // Clamped knots with random distinct interior knots.
+    std::vector<double> RandomKnots(std::mt19937& generator, size_t nb_ctrl_pts)
+    {
+        std::uniform_real_distribution<double> interior(0.0, 1.0);
+        std::vector<double> knots(nb_ctrl_pts + 4, 0.0);
+        for (size_t i = 4; i < nb_ctrl_pts; ++i)
+        {
+            knots[i] = interior(generator);
+        }
+        std::sort(knots.begin() + 4, knots.begin() + static_cast<std::ptrdiff_t>(nb_ctrl_pts));
+        std::fill(knots.end() - 4, knots.end(), 1.0);
+        return knots;
+    }
+
+    // Random parameters in [0, 1), with every knot and the middle of every span.
+    std::vector<double> TestParameters(std::mt19937& generator, const std::vector<double>& knots)
+    {
+        std::uniform_real_distribution<double> parameter(0.0, 1.0);
+        std::vector<double> t(500);
+        for (double& ti : t)
+        {
+            ti = parameter(generator);
+        }
+        for (size_t i = 3; i + 4 < knots.size(); ++i)
+        {
+            t.push_back(knots[i]);
+            t.push_back(0.5 * (knots[i] + knots[i + 1]));
+        }
+        return t;
+    }
+
+    void TestSpline(std::mt19937& generator, const CubicBSpline2d& spline)
+    {
+        std::vector<double> t = TestParameters(generator, spline.m_knots);
+        for (double ti : t)
+        {
+            double magnitude;
+            const glm::dvec2 point = Reference(spline, ti, 0, magnitude);
+            SPLINE_CHECK(IsClose(spline.Eval(ti), point, magnitude));
+
+            const glm::dvec2 first_derivative = Reference(spline, ti, 1, magnitude);
+            SPLINE_CHECK(IsClose(spline.EvalFirstDerivative(ti), first_derivative, magnitude));
+
+            const glm::dvec2 second_derivative = Reference(spline, ti, 2, magnitude);
+            SPLINE_CHECK(IsClose(spline.EvalSecondDerivative(ti), second_derivative, magnitude));
+        }
+
+        // Batched, in random order then sorted as discretizations pass them.
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            if (pass == 1)
+            {
+                std::sort(t.begin(), t.end());
+            }
+
+            std::vector<glm::vec2> points(t.size());
+            spline.Eval(t, points);
+            for (size_t i = 0; i < t.size(); ++i)
+            {
+                double magnitude;
+                const glm::dvec2 point = Reference(spline, t[i], 0, magnitude);
+                SPLINE_CHECK(IsClose(points[i], point, magnitude));
+            }
+        }
+
+        // The last basis function is 1 at the end, where the half open spans of the definition miss it.
+        SPLINE_CHECK(spline.Eval(1.0) == spline.m_ctrl_pts.back());
+        SPLINE_CHECK(spline.Eval(0.0) == spline.m_ctrl_pts.front());
+    }
+
+    // Non-finite parameters come out as the nearest end, NaN as the first one, without stalling the span walk.
+    void TestNonFiniteParameters(const CubicBSpline2d& spline)
+    {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        const double infinity = std::numeric_limits<double>::infinity();
+        const std::vector<double> t = { 0.1, nan, 0.2, 0.3, nan, nan, 0.9, infinity, -infinity, 0.5 };
+
+        std::vector<glm::vec2> points(t.size());
+        spline.Eval(t, points);
+        for (size_t i = 0; i < t.size(); ++i)
+        {
+            const glm::vec2 expected = std::isnan(t[i]) ? spline.m_ctrl_pts.front() : spline.Eval(t[i]);
+            SPLINE_CHECK(glm::length(points[i] - expected) <= 1e-3f);
+        }
+        SPLINE_CHECK(spline.Eval(nan) == spline.m_ctrl_pts.front());
+        SPLINE_CHECK(spline.Eval(infinity) == spline.m_ctrl_pts.back());
+        SPLINE_CHECK(spline.Eval(-infinity) == spline.m_ctrl_pts.front());
+    }
+}
+
+int main()
+{
+    std::mt19937 generator(1);
+    for (size_t nb_ctrl_pts : { 4, 5, 7, 16, 61 })
+    {
+        const std::vector<glm::vec2> points = RandomPoints(generator, nb_ctrl_pts);
+        TestSpline(generator, CubicBSpline2d(points));
+        TestSpline(generator, CubicBSpline2d(points, RandomKnots(generator, nb_ctrl_pts)));
+        TestNonFiniteParameters(CubicBSpline2d(points));
+    }
+
+    return Check::Result();
+}
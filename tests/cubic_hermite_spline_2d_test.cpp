@@ -0,0 +1,149 @@
+// Hermite curves against the Hermite basis on their tangents, the splines built from points and
+// tangents, and the pieces and local parameters their double parameters fall on.
+
+#include "../src/cubic_hermite_spline_2d/cubic_hermite_spline_2d.h"
+#include "../src/cubic_polynomial_2d/cubic_polynomial_2d.h"
+#include "check.h"
+
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    std::vector<glm::vec2> RandomPoints(std::mt19937& generator, size_t nb_points)
+    {
+        std::uniform_real_distribution<float> coordinate(-100.f, 100.f);
+        std::vector<glm::vec2> points(nb_points);
+        for (glm::vec2& point : points)
+        {
+            point = glm::vec2(coordinate(generator), coordinate(generator));
+        }
+        return points;
+    }
+
+    bool AreClose(const glm::vec2& a, const glm::vec2& b)
+    {
+        return glm::length(a - b) <= 1e-3f;
+    }
+
+    // The curve from P0 to P1 with the tangents N0 and N1, in the Hermite basis the editor scales
+    // them with, and its derivatives.
+    struct hermite_basis
+    {
+        glm::vec2 P0, P1, N0, N1;
+
+        glm::vec2 Eval(float u) const
+        {
+            return P0 * (2.f * u * u * u - 3.f * u * u + 1.f)
+                + N0 * (3.f * u * u * u - 6.f * u * u + 3.f * u)
+                + P1 * (-2.f * u * u * u + 3.f * u * u)
+                + N1 * (-3.f * u * u * u + 3.f * u * u);
+        }
+
+        glm::vec2 EvalFirstDerivative(float u) const
+        {
+            return P0 * (6.f * u * u - 6.f * u)
+                + N0 * (9.f * u * u - 12.f * u + 3.f)
+                + P1 * (-6.f * u * u + 6.f * u)
+                + N1 * (-9.f * u * u + 6.f * u);
+        }
+
+        glm::vec2 EvalSecondDerivative(float u) const
+        {
+            return P0 * (12.f * u - 6.f) + N0 * (18.f * u - 12.f) + P1 * (-12.f * u + 6.f) + N1 * (-18.f * u + 6.f);
+        }
+    };
+
+    void TestCurves(std::mt19937& generator)
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            const std::vector<glm::vec2> P = RandomPoints(generator, 4);
+            const hermite_basis basis{ P[0], P[3], P[1] - P[0], P[2] - P[3] };
+            const CubicHermiteCurve2d curve(P[0], P[1], P[2], P[3]);
+            const CubicHermiteCurve2d from_tangents = CubicHermiteCurve2d::FromTangents(basis.P0, basis.P1, basis.N0, basis.N1);
+
+            std::vector<float> u(17);
+            for (size_t j = 0; j < u.size(); ++j)
+            {
+                u[j] = static_cast<float>(j) / static_cast<float>(u.size() - 1);
+            }
+            std::vector<glm::vec2> pts(u.size());
+            curve.Eval(u, pts);
+
+            for (size_t j = 0; j < u.size(); ++j)
+            {
+                SPLINE_CHECK(AreClose(curve.Eval(u[j]), basis.Eval(u[j])));
+                SPLINE_CHECK(AreClose(from_tangents.Eval(u[j]), basis.Eval(u[j])));
+                SPLINE_CHECK(AreClose(pts[j], basis.Eval(u[j])));
+                SPLINE_CHECK(AreClose(curve.EvalFirstDerivative(u[j]), basis.EvalFirstDerivative(u[j])));
+                SPLINE_CHECK(AreClose(curve.EvalSecondDerivative(u[j]), basis.EvalSecondDerivative(u[j])));
+            }
+        }
+    }
+
+    // Pairs of points with their tangents, one curve between the points of each pair.
+    void TestTangents(std::mt19937& generator)
+    {
+        const std::vector<glm::vec2> points = RandomPoints(generator, 8);
+        const std::vector<glm::vec2> tangents = RandomPoints(generator, 8);
+        const CubicHermiteSpline2d spline(points, tangents);
+
+        SPLINE_CHECK(spline.m_curves.size() == 4);
+        for (size_t i = 0; i < spline.m_curves.size(); ++i)
+        {
+            const hermite_basis basis{ points[2 * i], points[2 * i + 1], tangents[2 * i], tangents[2 * i + 1] };
+            for (float u : { 0.f, 0.25f, 0.5f, 1.f })
+            {
+                SPLINE_CHECK(AreClose(spline.m_curves[i].Eval(u), basis.Eval(u)));
+            }
+        }
+    }
+
+    // Pieces found in double, far more than a float parameter tells apart.
+    void TestPieces(std::mt19937& generator)
+    {
+        constexpr size_t nb_pieces = 1 << 20;
+        SPLINE_CHECK(CubicPolynomial2d::FindPiece(nb_pieces, -1.0) == std::make_pair(size_t(0), 0.f));
+        SPLINE_CHECK(CubicPolynomial2d::FindPiece(nb_pieces, std::nan("")) == std::make_pair(size_t(0), 0.f));
+        SPLINE_CHECK(CubicPolynomial2d::FindPiece(nb_pieces, 1.0) == std::make_pair(nb_pieces - 1, 1.f));
+        SPLINE_CHECK(CubicPolynomial2d::FindPiece(nb_pieces, 2.0) == std::make_pair(nb_pieces - 1, 1.f));
+
+        const auto [last, u_last] = CubicPolynomial2d::FindPiece(nb_pieces, std::nextafter(1.0, 0.0));
+        SPLINE_CHECK(last == nb_pieces - 1 && u_last > 0.99f && u_last <= 1.f);
+
+        std::uniform_int_distribution<size_t> piece(0, nb_pieces - 1);
+        for (int i = 0; i < 1000; ++i)
+        {
+            const size_t expected = piece(generator);
+            const double t = (static_cast<double>(expected) + 0.25) / static_cast<double>(nb_pieces);
+            const auto [found, u] = CubicPolynomial2d::FindPiece(nb_pieces, t);
+            SPLINE_CHECK(found == expected && u == 0.25f);
+        }
+
+        // The spline evaluates the curve of the piece at its parameter, ends included.
+        const std::vector<glm::vec2> points = RandomPoints(generator, 4 * 1000);
+        const CubicHermiteSpline2d spline(points);
+        for (int i = 0; i < 1000; ++i)
+        {
+            const double t = (static_cast<double>(i) + 0.75) / 1000.0;
+            const CubicHermiteCurve2d& curve = spline.m_curves[static_cast<size_t>(i)];
+            SPLINE_CHECK(spline.Eval(t) == curve.Eval(0.75f));
+            SPLINE_CHECK(spline.EvalFirstDerivative(t) == curve.EvalFirstDerivative(0.75f));
+        }
+        SPLINE_CHECK(spline.Eval(0.0) == points.front());
+        SPLINE_CHECK(spline.Eval(1.0) == points.back());
+    }
+}
+
+int main()
+{
+    std::mt19937 generator(1);
+    TestCurves(generator);
+    TestTangents(generator);
+    TestPieces(generator);
+
+    return Check::Result();
+}
@@ -0,0 +1,85 @@
+// Forward differencing, as the scene tessellates, against the evaluation of every sample by Linear.
+
+#include "../src/discretization/discretization.h"
+#include "check.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // Canvas coordinates up to 1000 : the differences are stepped in float, a hundredth of a pixel
+    // leaves room for their rounding over the samples between two seeds.
+    constexpr float max_error = 1e-2f;
+
+    std::vector<glm::vec2> RandomPoints(std::mt19937& generator, size_t nb_points)
+    {
+        std::uniform_real_distribution<float> coordinate(0.f, 1000.f);
+        std::vector<glm::vec2> points(nb_points);
+        for (glm::vec2& point : points)
+        {
+            point = glm::vec2(coordinate(generator), coordinate(generator));
+        }
+        return points;
+    }
+
+    // Clamped knots with random distinct interior knots.
+    std::vector<double> RandomKnots(std::mt19937& generator, size_t nb_ctrl_pts)
+    {
+        std::uniform_real_distribution<double> interior(0.0, 1.0);
+        std::vector<double> knots(nb_ctrl_pts + 4, 0.0);
+        for (size_t i = 4; i < nb_ctrl_pts; ++i)
+        {
+            knots[i] = interior(generator);
+        }
+        std::sort(knots.begin() + 4, knots.begin() + static_cast<std::ptrdiff_t>(nb_ctrl_pts));
+        std::fill(knots.end() - 4, knots.end(), 1.0);
+        return knots;
+    }
+
+    // The whole spline within max_error of Linear, and any range of samples as the whole spline does.
+    template <class Spline>
+    void TestSpline(std::mt19937& generator, const Spline& spline)
+    {
+        // The editor's discretization range, and beyond the reseed interval of the differences.
+        for (uint32_t nb_pts : { 2u, 3u, 10u, 100u, 200u, 1000u })
+        {
+            const std::vector<glm::vec2> reference = Discretization::Linear(spline, nb_pts);
+            const std::vector<glm::vec2> pts = Discretization::ForwardDifferencing(spline, nb_pts);
+            const Discretization::AccuracyReport report = Discretization::MeasureAccuracy(reference, pts);
+            SPLINE_CHECK(report.max_error <= max_error);
+            SPLINE_CHECK(report.mean_error <= report.max_error);
+
+            std::uniform_int_distribution<size_t> sample(0, nb_pts - 1);
+            for (int i = 0; i < 8; ++i)
+            {
+                size_t first = sample(generator);
+                size_t last = sample(generator);
+                if (first > last)
+                {
+                    std::swap(first, last);
+                }
+                std::vector<glm::vec2> range(last + 1 - first);
+                Discretization::ForwardDifferencing(spline, nb_pts, first, range);
+                const Discretization::AccuracyReport range_report = Discretization::MeasureAccuracy(std::span(reference).subspan(first, range.size()), range);
+                SPLINE_CHECK(range_report.max_error <= max_error);
+            }
+        }
+    }
+}
+
+int main()
+{
+    std::mt19937 generator(1);
+    for (size_t nb_curves : { 1, 2, 5, 32 })
+    {
+        const std::vector<glm::vec2> points = RandomPoints(generator, 4 * nb_curves);
+        TestSpline(generator, CubicBezierSpline2d(points));
+        TestSpline(generator, CubicHermiteSpline2d(points));
+        TestSpline(generator, CubicBSpline2d(points));
+        TestSpline(generator, CubicBSpline2d(points, RandomKnots(generator, points.size())));
+    }
+
+    return Check::Result();
+}
@@ -0,0 +1,100 @@
+// Normals drawn by DrawListBuilder, in an ImGui context without backend.
+
+#include "../src/draw_list_builder/draw_list_builder.h"
+#include "check.h"
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+namespace
+{
+    // The normal strokes are the vertices of the normal color, emitted after the stroke and the markers,
+    // the same number for each of their 2 points. Checks that the end of each of them is the quarter
+    // counterclockwise turn of the tangent at its point, of the style's length.
+    void TestNormals(ImDrawList* draw_list, const DrawListBuilder& builder, const DrawListBuilder::Style& style, const std::vector<glm::vec2>& points)
+    {
+        const int first_vertex = draw_list->VtxBuffer.Size;
+        builder.Emit(draw_list, glm::vec2(0.f));
+
+        std::vector<glm::vec2> normal_vertices;
+        for (int i = first_vertex; i < draw_list->VtxBuffer.Size; ++i)
+        {
+            const ImDrawVert& vertex = draw_list->VtxBuffer[i];
+            if ((vertex.col | IM_COL32_A_MASK) == (style.normal_color | IM_COL32_A_MASK))
+            {
+                normal_vertices.emplace_back(vertex.pos.x, vertex.pos.y);
+            }
+        }
+
+        const size_t nb_normals = points.size() - 2;
+        SPLINE_CHECK(!normal_vertices.empty() && normal_vertices.size() % (2 * nb_normals) == 0);
+        if (normal_vertices.empty() || normal_vertices.size() % (2 * nb_normals) != 0)
+        {
+            return;
+        }
+
+        const size_t vertices_per_point = normal_vertices.size() / (2 * nb_normals);
+        for (size_t n = 1; n + 1 < points.size(); ++n)
+        {
+            // Across the stroke the vertices are symmetric about its point.
+            const size_t first = (2 * (n - 1) + 1) * vertices_per_point;
+            glm::vec2 end(0.f);
+            for (size_t i = 0; i < vertices_per_point; ++i)
+            {
+                end += normal_vertices[first + i];
+            }
+            end /= static_cast<float>(vertices_per_point);
+
+            const glm::vec2 normal = end - points[n];
+            const glm::vec2 tangent = glm::normalize(points[n + 1] - points[n - 1]);
+            SPLINE_CHECK(std::abs(glm::dot(normal, tangent)) <= 1e-3f * style.normal_length);
+            SPLINE_CHECK(std::abs(glm::length(normal) - style.normal_length) <= 1e-3f * style.normal_length);
+            SPLINE_CHECK(glm::length(normal - glm::vec2(-tangent.y, tangent.x) * style.normal_length) <= 1e-3f * style.normal_length);
+        }
+    }
+}
+
+int main()
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1280.f, 720.f);
+    io.DeltaTime = 1.f / 60.f;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    io.IniFilename = nullptr;
+
+    // A straight line, and an arc whose tangent turns all around.
+    std::vector<std::vector<glm::vec2>> polylines;
+    polylines.push_back({ { 100.f, 100.f }, { 200.f, 100.f }, { 300.f, 100.f }, { 400.f, 100.f } });
+    std::vector<glm::vec2>& arc = polylines.emplace_back();
+    for (int i = 0; i < 40; ++i)
+    {
+        const float angle = 2.f * std::numbers::pi_v<float> * static_cast<float>(i) / 36.f;
+        arc.emplace_back(640.f + 200.f * std::cos(angle), 360.f + 200.f * std::sin(angle));
+    }
+
+    const DrawListBuilder::Style style;
+    DrawListBuilder unbaked(style);
+    DrawListBuilder baked(style);
+    baked.Bake(io.Fonts);
+
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0.f, 0.f));
+    ImGui::SetNextWindowSize(io.DisplaySize);
+    ImGui::Begin("canvas");
+    for (DrawListBuilder* builder : { &unbaked, &baked })
+    {
+        for (const auto& points : polylines)
+        {
+            builder->Clear();
+            builder->AddPolyline(points, true);
+            TestNormals(ImGui::GetWindowDrawList(), *builder, style, points);
+        }
+    }
+    ImGui::End();
+    ImGui::Render();
+    ImGui::DestroyContext();
+
+    return Check::Result();
+}
@@ -0,0 +1,80 @@
+// Recordings load as they were saved, and Load rejects the files whose counts do not fit in them.
+
+#include "../src/input_recorder/input_recorder.h"
+#include "check.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace
+{
+    // Layout of the file header, the counts follow the magic, version and frame size.
+    constexpr std::streamoff nb_frames_offset = 16;
+    constexpr std::streamoff nb_characters_offset = 24;
+
+    std::string TempPath(const char* name)
+    {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    void Record(const std::string& path, int nb_frames)
+    {
+        ImGui::CreateContext();
+        ImGuiIO& io = ImGui::GetIO();
+        io.DisplaySize = ImVec2(1280.f, 720.f);
+        io.DeltaTime = 1.f / 60.f;
+        io.IniFilename = nullptr;
+        io.Fonts->Build();
+
+        InputRecorder recorder;
+        for (int i = 0; i < nb_frames; ++i)
+        {
+            io.AddMousePosEvent(static_cast<float>(10 * i), 20.f);
+            io.AddInputCharacter('a' + i);
+            ImGui::NewFrame();
+            recorder.Record();
+            ImGui::EndFrame();
+        }
+        SPLINE_CHECK(recorder.Save(path.c_str()));
+        ImGui::DestroyContext();
+    }
+
+    void Patch(const std::string& path, std::streamoff offset, uint64_t value)
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(offset);
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+}
+
+int main()
+{
+    const std::string path = TempPath("spline_input_recorder_test.rec");
+    constexpr int nb_frames = 5;
+
+    Record(path, nb_frames);
+    const std::optional<InputReplay> replay = InputReplay::Load(path.c_str());
+    SPLINE_CHECK(replay.has_value() && replay->GetNbFrames() == nb_frames);
+
+    // Counts far larger than the file, that must not be allocated.
+    Patch(path, nb_frames_offset, uint64_t(1) << 60);
+    SPLINE_CHECK(!InputReplay::Load(path.c_str()));
+
+    Record(path, nb_frames);
+    Patch(path, nb_characters_offset, UINT64_MAX);
+    SPLINE_CHECK(!InputReplay::Load(path.c_str()));
+
+    // One frame more than written.
+    Record(path, nb_frames);
+    Patch(path, nb_frames_offset, nb_frames + 1);
+    SPLINE_CHECK(!InputReplay::Load(path.c_str()));
+
+    // Truncated in the characters.
+    Record(path, nb_frames);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    SPLINE_CHECK(!InputReplay::Load(path.c_str()));
+
+    std::filesystem::remove(path);
+    return Check::Result();
+}
@@ -0,0 +1,166 @@
+// Scene files written by SceneFile::Write open as they were saved, Open rejects the records the
+// spline constructors cannot build or tessellate, and CopyTo leaves out the non finite points.
+
+#include "../src/scene_file/scene_file.h"
+#include "check.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const std::vector<glm::vec2> points = { { 0.f, 0.f }, { 10.f, 20.f }, { 30.f, 20.f }, { 40.f, 0.f },
+                                            { 50.f, -20.f }, { 70.f, -20.f }, { 80.f, 0.f }, { 90.f, 10.f } };
+
+    std::string TempPath(const char* name)
+    {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    void TestRoundTrip(const std::string& path)
+    {
+        data saved;
+        saved.add_spline(points, spline_type::BEZIER, glm::uvec3(255, 0, 0), 16);
+        saved.add_spline(points, spline_type::HERMITE, glm::uvec3(0, 255, 0), 8);
+        saved.add_spline(std::span(points).first(5), spline_type::BSPLINE, glm::uvec3(0, 0, 255), 4);
+        SPLINE_CHECK(SceneFile::Write(path.c_str(), saved));
+
+        const std::optional<MappedScene> scene = MappedScene::Open(path.c_str());
+        SPLINE_CHECK(scene.has_value());
+        if (!scene)
+        {
+            return;
+        }
+
+        SPLINE_CHECK(scene->GetNbSplines() == 3);
+        for (size_t i = 0; i < scene->GetNbSplines(); ++i)
+        {
+            const std::span<const glm::vec2> loaded = scene->GetPoints(i);
+            const std::span<const glm::vec2> expected = saved.get_points(i);
+            SPLINE_CHECK(std::equal(loaded.begin(), loaded.end(), expected.begin(), expected.end()));
+            SPLINE_CHECK(scene->GetType(i) == saved.splines_type[i]);
+            SPLINE_CHECK(scene->GetColor(i) == saved.splines_color[i]);
+            SPLINE_CHECK(scene->GetDiscretization(i) == saved.splines_discretization[i]);
+        }
+    }
+
+    // One spline saved valid, then its record rewritten in place by patch.
+    template <class Patch>
+    bool OpensWithPatchedRecord(const std::string& path, Patch patch)
+    {
+        data saved;
+        saved.add_spline(points, spline_type::BEZIER);
+        if (!SceneFile::Write(path.c_str(), saved))
+        {
+            return true;
+        }
+
+        SceneFile::header h;
+        SceneFile::spline_record record;
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.read(reinterpret_cast<char*>(&h), sizeof(h));
+        file.seekg(static_cast<std::streamoff>(h.splines_offset));
+        file.read(reinterpret_cast<char*>(&record), sizeof(record));
+        patch(record);
+        file.seekp(static_cast<std::streamoff>(h.splines_offset));
+        file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        file.close();
+
+        return MappedScene::Open(path.c_str()).has_value();
+    }
+
+    bool OpensWithRecord(const std::string& path, spline_type type, uint32_t nb_points)
+    {
+        return OpensWithPatchedRecord(path, [&](SceneFile::spline_record& record)
+            {
+                record.type = static_cast<uint32_t>(type);
+                record.nb_points = nb_points;
+            });
+    }
+
+    bool OpensWithDiscretization(const std::string& path, int32_t discretization)
+    {
+        return OpensWithPatchedRecord(path, [&](SceneFile::spline_record& record) { record.discretization = discretization; });
+    }
+
+    // Unknown draw option bits are dropped.
+    void TestDrawOptions(const std::string& path)
+    {
+        SPLINE_CHECK(OpensWithPatchedRecord(path, [](SceneFile::spline_record& record) { record.draw_options = UINT32_MAX; }));
+
+        const std::optional<MappedScene> scene = MappedScene::Open(path.c_str());
+        SPLINE_CHECK(scene && scene->GetDrawOptions(0) == all_draw_options);
+    }
+
+    // A spline with a non finite point is left out of the editor scene, the others are copied.
+    void TestNonFinitePoints(const std::string& path, float value)
+    {
+        data saved;
+        saved.add_spline(points, spline_type::BEZIER, glm::uvec3(255, 0, 0));
+        saved.add_spline(points, spline_type::BSPLINE, glm::uvec3(0, 0, 255));
+        saved.add_spline(points, spline_type::HERMITE, glm::uvec3(0, 255, 0));
+        SPLINE_CHECK(SceneFile::Write(path.c_str(), saved));
+
+        SceneFile::header h;
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.read(reinterpret_cast<char*>(&h), sizeof(h));
+        file.seekp(static_cast<std::streamoff>(h.points_offset + (points.size() + 3) * sizeof(glm::vec2) + sizeof(float)));
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        file.close();
+
+        const std::optional<MappedScene> scene = MappedScene::Open(path.c_str());
+        SPLINE_CHECK(scene.has_value());
+        if (!scene)
+        {
+            return;
+        }
+
+        data loaded;
+        scene->CopyTo(loaded);
+        SPLINE_CHECK(loaded.get_nb_splines() == 2 && loaded.splines_type[0] == spline_type::BEZIER && loaded.splines_type[1] == spline_type::HERMITE);
+    }
+}
+
+int main()
+{
+    const std::string path = TempPath("spline_scene_file_test.bin");
+
+    TestRoundTrip(path);
+
+    // Hermite curves take 4 points each.
+    SPLINE_CHECK(OpensWithRecord(path, spline_type::HERMITE, 8));
+    SPLINE_CHECK(!OpensWithRecord(path, spline_type::HERMITE, 6));
+    SPLINE_CHECK(!OpensWithRecord(path, spline_type::HERMITE, 0));
+
+    // Bezier splines need a whole curve, the trailing points of the last one are kept.
+    SPLINE_CHECK(OpensWithRecord(path, spline_type::BEZIER, 6));
+    SPLINE_CHECK(!OpensWithRecord(path, spline_type::BEZIER, 2));
+    SPLINE_CHECK(!OpensWithRecord(path, spline_type::BEZIER, 0));
+
+    // B-splines need the 4 points of a knot span.
+    SPLINE_CHECK(OpensWithRecord(path, spline_type::BSPLINE, 4));
+    SPLINE_CHECK(!OpensWithRecord(path, spline_type::BSPLINE, 3));
+
+    // Unknown type.
+    SPLINE_CHECK(!OpensWithRecord(path, static_cast<spline_type>(3), 8));
+
+    // The discretization sizes the tessellation, only the editor range is accepted.
+    SPLINE_CHECK(OpensWithDiscretization(path, min_discretization));
+    SPLINE_CHECK(OpensWithDiscretization(path, max_discretization));
+    SPLINE_CHECK(!OpensWithDiscretization(path, min_discretization - 1));
+    SPLINE_CHECK(!OpensWithDiscretization(path, max_discretization + 1));
+    SPLINE_CHECK(!OpensWithDiscretization(path, INT32_MAX));
+    SPLINE_CHECK(!OpensWithDiscretization(path, INT32_MIN));
+
+    TestDrawOptions(path);
+
+    TestNonFinitePoints(path, std::numeric_limits<float>::quiet_NaN());
+    TestNonFinitePoints(path, std::numeric_limits<float>::infinity());
+
+    std::filesystem::remove(path);
+    return Check::Result();
+}
@@ -0,0 +1,247 @@
+// Random edits of a scene, undone and redone in any order, give back the scene as it was after each
+// of them, and an entry only costs the chunks its edit changed.
+
+#include "../src/scene_history/scene_history.h"
+#include "check.h"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    struct spline_snapshot
+    {
+        std::vector<glm::vec2> points;
+        spline_type type;
+        glm::uvec3 color;
+        int32_t discretization;
+        draw_option draw_options;
+
+        bool operator==(const spline_snapshot&) const = default;
+    };
+
+    std::vector<spline_snapshot> Snapshot(const data& data)
+    {
+        std::vector<spline_snapshot> snapshot;
+        for (size_t i = 0; i < data.get_nb_splines(); ++i)
+        {
+            const std::span<const glm::vec2> points = data.get_points(i);
+            snapshot.push_back({ std::vector<glm::vec2>(points.begin(), points.end()), data.splines_type[i], data.splines_color[i],
+                                 data.splines_discretization[i], data.splines_draw_options[i] });
+        }
+        return snapshot;
+    }
+
+    // Whole curves of every type, some spanning several chunks.
+    std::vector<glm::vec2> RandomPoints(std::mt19937& generator)
+    {
+        std::uniform_int_distribution<size_t> nb_curves(1, 40);
+        std::uniform_real_distribution<float> coordinate(0.f, 1000.f);
+        std::vector<glm::vec2> points(4 * nb_curves(generator));
+        for (glm::vec2& point : points)
+        {
+            point = glm::vec2(coordinate(generator), coordinate(generator));
+        }
+        return points;
+    }
+
+    // The scene after every committed edit, the history entries between them.
+    struct timeline
+    {
+        std::vector<std::vector<spline_snapshot>> snapshots;
+        size_t current = 0;
+
+        void Push(const data& data)
+        {
+            snapshots.resize(current + 1);
+            snapshots.push_back(Snapshot(data));
+            ++current;
+        }
+    };
+
+    // Color, draw options and discretization changed as the properties panel does.
+    void EditProperties(data& data, SceneHistory& history, size_t index)
+    {
+        data.splines_color[index] = glm::uvec3(data.splines_color[index].r ^ 1, 0, 0);
+        data.splines_draw_options[index] ^= draw_option::CONTROL_POLYGON;
+        data.splines_discretization[index] = data.splines_discretization[index] == 100 ? 50 : 100;
+        data.invalidate_spline(index);
+        history.MarkChanged(index);
+    }
+
+    void TestRandomEdits(std::mt19937& generator)
+    {
+        data data;
+        SceneHistory history;
+        for (int i = 0; i < 4; ++i)
+        {
+            data.add_spline(RandomPoints(generator), static_cast<spline_type>(i % 3));
+        }
+        history.Reset(data);
+
+        timeline timeline;
+        timeline.snapshots.push_back(Snapshot(data));
+
+        std::uniform_int_distribution<int> operation(0, 9);
+        std::uniform_real_distribution<float> offset(1.f, 10.f);
+        for (int step = 0; step < 2000; ++step)
+        {
+            const size_t nb_splines = data.get_nb_splines();
+            const size_t index = std::uniform_int_distribution<size_t>(0, nb_splines - 1)(generator);
+            switch (operation(generator))
+            {
+            case 0:
+            case 1:
+            {
+                // A drag, marked every frame and committed once.
+                const size_t point = std::uniform_int_distribution<size_t>(0, data.get_points(index).size() - 1)(generator);
+                for (int frame = 0; frame < 3; ++frame)
+                {
+                    data.move_control_point(index, point, data.get_points(index)[point] + glm::vec2(offset(generator), 0.f));
+                    history.MarkChanged(index);
+                }
+                history.Commit(data);
+                timeline.Push(data);
+                break;
+            }
+            case 2:
+            {
+                // Undo and Redo commit the edits marked in the same frame first : Undo takes them
+                // back, there is nothing to redo after them.
+                EditProperties(data, history, index);
+                timeline.Push(data);
+                if (step % 3 == 1)
+                {
+                    SPLINE_CHECK(history.Undo(data));
+                    --timeline.current;
+                }
+                else if (step % 3 == 2)
+                {
+                    SPLINE_CHECK(!history.Redo(data));
+                }
+                break;
+            }
+            case 3:
+            {
+                // Marked without any change, no entry.
+                history.MarkChanged(index);
+                history.Commit(data);
+                break;
+            }
+            case 4:
+            {
+                const size_t first_index = data.get_nb_splines();
+                data.add_spline(RandomPoints(generator), static_cast<spline_type>(step % 3));
+                history.CommitAddedSplines(data, first_index);
+                timeline.Push(data);
+                break;
+            }
+            case 5:
+            {
+                if (nb_splines > 1)
+                {
+                    // Edits of the removed spline not committed yet are lost, those of the spline
+                    // taking its place are committed on their own.
+                    if (step % 2 == 1)
+                    {
+                        EditProperties(data, history, index);
+                        EditProperties(data, history, nb_splines - 1);
+                        if (index != nb_splines - 1)
+                        {
+                            std::vector<spline_snapshot> edited = Snapshot(data);
+                            edited[index] = timeline.snapshots[timeline.current][index];
+                            timeline.snapshots.resize(timeline.current + 1);
+                            timeline.snapshots.push_back(std::move(edited));
+                            ++timeline.current;
+                        }
+                    }
+                    data.remove_spline(index);
+                    history.CommitRemovedSpline(data, index);
+                    timeline.Push(data);
+                }
+                break;
+            }
+            case 6:
+            case 7:
+            {
+                const bool is_undone = history.Undo(data);
+                SPLINE_CHECK(is_undone == (timeline.current > 0));
+                timeline.current -= is_undone ? 1 : 0;
+                break;
+            }
+            default:
+            {
+                const bool is_redone = history.Redo(data);
+                SPLINE_CHECK(is_redone == (timeline.current + 1 < timeline.snapshots.size()));
+                timeline.current += is_redone ? 1 : 0;
+                break;
+            }
+            }
+
+            // Once a frame in the editor.
+            history.Commit(data);
+            SPLINE_CHECK(Snapshot(data) == timeline.snapshots[timeline.current]);
+            SPLINE_CHECK(history.GetNbEntries() + 1 == timeline.snapshots.size());
+        }
+
+        // Every entry undone then redone.
+        while (history.Undo(data))
+        {
+            SPLINE_CHECK(Snapshot(data) == timeline.snapshots[--timeline.current]);
+        }
+        SPLINE_CHECK(timeline.current == 0);
+        while (history.Redo(data))
+        {
+            SPLINE_CHECK(Snapshot(data) == timeline.snapshots[++timeline.current]);
+        }
+        SPLINE_CHECK(timeline.current + 1 == timeline.snapshots.size());
+    }
+
+    // Moving one point of a long spline copies its chunk only, a property edit none.
+    void TestSharedChunks()
+    {
+        constexpr size_t nb_chunks = 8;
+        std::vector<glm::vec2> points(nb_chunks * SceneHistory::chunk_size);
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            points[i] = glm::vec2(static_cast<float>(i), 0.f);
+        }
+
+        data data;
+        data.add_spline(points, spline_type::BSPLINE);
+        SceneHistory history;
+        history.Reset(data);
+
+        data.move_control_point(0, 3 * SceneHistory::chunk_size + 5, glm::vec2(-1.f));
+        history.MarkChanged(0);
+        history.Commit(data);
+        const size_t moved_bytes = history.GetMemoryUsage();
+        SPLINE_CHECK(moved_bytes >= sizeof(SceneHistory::chunk) && moved_bytes < 2 * sizeof(SceneHistory::chunk));
+
+        data.splines_color[0] = glm::uvec3(0);
+        history.MarkChanged(0);
+        history.Commit(data);
+        SPLINE_CHECK(history.GetMemoryUsage() - moved_bytes < sizeof(SceneHistory::chunk));
+
+        // Undone edits give their chunks back once a new edit drops them.
+        SPLINE_CHECK(history.Undo(data) && history.Undo(data));
+        data.splines_discretization[0] = 10;
+        history.MarkChanged(0);
+        history.Commit(data);
+        SPLINE_CHECK(history.GetNbEntries() == 1 && history.GetMemoryUsage() < sizeof(SceneHistory::chunk));
+    }
+}
+
+int main()
+{
+    for (uint32_t seed : { 1u, 2u, 3u })
+    {
+        std::mt19937 generator(seed);
+        TestRandomEdits(generator);
+    }
+    TestSharedChunks();
+
+    return Check::Result();
+}
@@ -0,0 +1,98 @@
+// Control point moves patch the cached scene as a rebuild from the moved points would build it.
+
+#include "../src/scene/scene.h"
+#include "check.h"
+
+#include <random>
+#include <vector>
+
+namespace
+{
+    bool AreClose(std::span<const glm::vec2> a, std::span<const glm::vec2> b)
+    {
+        if (a.size() != b.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (glm::length(a[i] - b[i]) > 1e-3f)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Every point of the spline moved in turn, with the trees built, against a scene built from the moved points.
+    void TestMoveEveryPoint(std::mt19937& generator, spline_type type, size_t nb_points)
+    {
+        std::uniform_real_distribution<float> coordinate(0.f, 500.f);
+        std::vector<glm::vec2> points(nb_points);
+        for (glm::vec2& point : points)
+        {
+            point = glm::vec2(coordinate(generator), coordinate(generator));
+        }
+
+        data moved;
+        moved.add_spline(points, type);
+        moved.get_tessellation(0);
+        moved.get_segments_bvh();
+        moved.get_splines_bvh();
+
+        for (size_t i = 0; i < nb_points; ++i)
+        {
+            points[i] = glm::vec2(coordinate(generator), coordinate(generator));
+            moved.move_control_point(0, i, points[i]);
+
+            data rebuilt;
+            rebuilt.add_spline(points, type);
+            SPLINE_CHECK(AreClose(moved.get_tessellation(0), rebuilt.get_tessellation(0)));
+            const BoundingBox2d& box = moved.splines_bounding_boxs[0];
+            const BoundingBox2d& rebuilt_box = rebuilt.splines_bounding_boxs[0];
+            SPLINE_CHECK(glm::length(box.min - rebuilt_box.min) <= 1e-3f && glm::length(box.max - rebuilt_box.max) <= 1e-3f);
+
+            const glm::vec2 query(coordinate(generator), coordinate(generator));
+            const auto closest = moved.find_closest_curve_point(query, 1000.f);
+            const auto rebuilt_closest = rebuilt.find_closest_curve_point(query, 1000.f);
+            SPLINE_CHECK(closest.has_value() == rebuilt_closest.has_value());
+            if (closest && rebuilt_closest)
+            {
+                SPLINE_CHECK(glm::length(closest->point - rebuilt_closest->point) <= 1e-3f);
+            }
+        }
+    }
+
+    // A Bezier control point far from its curve is still found through the splines tree, as drawn.
+    void TestSplinesTreeHoldsControlPoints()
+    {
+        const std::vector<glm::vec2> points = { { 0.f, 0.f }, { 50.f, 1000.f }, { 100.f, 0.f }, { 150.f, 0.f } };
+        data scene;
+        scene.add_spline(points, spline_type::BEZIER);
+        SPLINE_CHECK(scene.splines_bounding_boxs[0].max.y < 1000.f);
+
+        size_t nb_found = 0;
+        scene.get_splines_bvh().Query(BoundingBox2d({ 40.f, 990.f }, { 60.f, 1010.f }), [&](uint32_t) { ++nb_found; });
+        SPLINE_CHECK(nb_found == 1);
+
+        scene.move_control_point(0, 1, { 50.f, 2000.f });
+        nb_found = 0;
+        scene.get_splines_bvh().Query(BoundingBox2d({ 40.f, 1990.f }, { 60.f, 2010.f }), [&](uint32_t) { ++nb_found; });
+        SPLINE_CHECK(nb_found == 1);
+    }
+}
+
+int main()
+{
+    std::mt19937 generator(1);
+
+    // Bezier points after the last whole curve are on no segment, they are still picked and dragged.
+    TestMoveEveryPoint(generator, spline_type::BEZIER, 8);
+    TestMoveEveryPoint(generator, spline_type::BEZIER, 10);
+    TestMoveEveryPoint(generator, spline_type::HERMITE, 8);
+    TestMoveEveryPoint(generator, spline_type::HERMITE, 12);
+    TestMoveEveryPoint(generator, spline_type::BSPLINE, 9);
+    TestSplinesTreeHoldsControlPoints();
+
+    return Check::Result();
+}
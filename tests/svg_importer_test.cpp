@@ -0,0 +1,230 @@
+// ReadFloat against std::from_chars, and the cubics and statistics of small path data for every
+// command : implicit repetition, reflected control points, relative commands after a closepath,
+// compact numbers and flags, syntax errors and paths longer than the input buffer.
+
+#include "../src/svg_importer/svg_importer.h"
+#include "check.h"
+
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    // Same value, sign of zero included, and same end as from_chars, which takes no plus sign.
+    bool ReadsAsFromChars(std::string_view text)
+    {
+        const char* first = text.data();
+        const char* last = text.data() + text.size();
+
+        float value = 0.f;
+        const char* end = SvgImporter::ReadFloat(first, last, value);
+
+        float expected = 0.f;
+        const char* expected_first = !text.empty() && text[0] == '+' ? first + 1 : first;
+        const auto [expected_end, error] = std::from_chars(expected_first, last, expected);
+        if (error != std::errc())
+        {
+            return end == nullptr;
+        }
+        return end == expected_end && std::bit_cast<uint32_t>(value) == std::bit_cast<uint32_t>(expected);
+    }
+
+    void TestReadFloat()
+    {
+        for (std::string_view text : { "0", "-0", "+0", "0.", ".0", "-.5", "+.5", "1.", "007", "1.5.5", "1-2", "1e", "1e5", "1E-3",
+                                       "2.5e+2", "-1e-45", "3.4e38", "1e39", "0.1", "0.3", "0.1234567", "1234567.", "16777216",
+                                       "16777217", "0.0000000001", "0.00000000001", "1.00000000000000000001", "99999999999999999999",
+                                       "123456789012345678901234567890", "-", "+", ".", "-.", "e5", "" })
+        {
+            SPLINE_CHECK(ReadsAsFromChars(text));
+        }
+
+        // Random decimals on either side of the fast path limits.
+        std::mt19937 generator(1);
+        std::uniform_int_distribution<int> nb_digits(0, 12);
+        std::uniform_int_distribution<int> digit(0, 9);
+        for (int i = 0; i < 100000; ++i)
+        {
+            std::string text = i % 3 == 0 ? "-" : "";
+            for (int n = nb_digits(generator); n > 0; --n)
+            {
+                text += static_cast<char>('0' + digit(generator));
+            }
+            text += '.';
+            for (int n = nb_digits(generator); n > 0; --n)
+            {
+                text += static_cast<char>('0' + digit(generator));
+            }
+            SPLINE_CHECK(ReadsAsFromChars(text));
+        }
+    }
+
+    struct parsed_path
+    {
+        std::vector<std::vector<glm::vec2>> subpaths;
+        SvgImporter::statistics statistics;
+    };
+
+    parsed_path ParsePath(std::string_view d)
+    {
+        std::istringstream in("<svg><!-- <path d=\"M0 0 L1 1\"/> --><path id='p' d=\"" + std::string(d) + "\"/></svg>");
+        parsed_path parsed;
+        parsed.statistics = SvgImporter::Parse(in, [&](std::span<const glm::vec2> points)
+            {
+                parsed.subpaths.emplace_back(points.begin(), points.end());
+            });
+        return parsed;
+    }
+
+    bool AreClose(const glm::vec2& a, const glm::vec2& b)
+    {
+        return glm::length(a - b) <= 1e-4f;
+    }
+
+    // Curve of the subpath, with its 4 control points.
+    bool IsCurve(const parsed_path& parsed, size_t subpath, size_t curve, std::array<glm::vec2, 4> P)
+    {
+        if (subpath >= parsed.subpaths.size() || 4 * curve + 4 > parsed.subpaths[subpath].size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < 4; ++i)
+        {
+            if (!AreClose(parsed.subpaths[subpath][4 * curve + i], P[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Lines are elevated to cubics with their control points at the thirds.
+    bool IsLine(const parsed_path& parsed, size_t subpath, size_t curve, const glm::vec2& a, const glm::vec2& b)
+    {
+        return IsCurve(parsed, subpath, curve, { a, a + (b - a) / 3.f, a + 2.f * (b - a) / 3.f, b });
+    }
+
+    bool HasStatistics(const parsed_path& parsed, size_t nb_subpaths, size_t nb_curves, size_t nb_errors)
+    {
+        return parsed.statistics.nb_paths == 1
+            && parsed.statistics.nb_subpaths == nb_subpaths
+            && parsed.subpaths.size() == nb_subpaths
+            && parsed.statistics.nb_curves == nb_curves
+            && parsed.statistics.nb_errors == nb_errors;
+    }
+
+    void TestCommands()
+    {
+        // Arguments repeat the command, those of a moveto are linetos.
+        {
+            const parsed_path parsed = ParsePath("M0 0 L10 0 20 10");
+            SPLINE_CHECK(HasStatistics(parsed, 1, 2, 0));
+            SPLINE_CHECK(IsLine(parsed, 0, 0, { 0, 0 }, { 10, 0 }));
+            SPLINE_CHECK(IsLine(parsed, 0, 1, { 10, 0 }, { 20, 10 }));
+        }
+        {
+            const parsed_path parsed = ParsePath("m1 1 2 0 0,2");
+            SPLINE_CHECK(HasStatistics(parsed, 1, 2, 0));
+            SPLINE_CHECK(IsLine(parsed, 0, 0, { 1, 1 }, { 3, 1 }));
+            SPLINE_CHECK(IsLine(parsed, 0, 1, { 3, 1 }, { 3, 3 }));
+        }
+        {
+            const parsed_path parsed = ParsePath("M0 0 H10 V10 h-5 v-5");
+            SPLINE_CHECK(HasStatistics(parsed, 1, 4, 0));
+            SPLINE_CHECK(IsLine(parsed, 0, 1, { 10, 0 }, { 10, 10 }));
+            SPLINE_CHECK(IsLine(parsed, 0, 3, { 5, 10 }, { 5, 5 }));
+        }
+
+        // S reflects the second control point of the previous cubic, the current point otherwise.
+        {
+            const parsed_path parsed = ParsePath("M0 0 C0 10 10 10 10 0 S20 -10 20 0 s10 10 10 0");
+            SPLINE_CHECK(HasStatistics(parsed, 1, 3, 0));
+            SPLINE_CHECK(IsCurve(parsed, 0, 0, { glm::vec2(0, 0), glm::vec2(0, 10), glm::vec2(10, 10), glm::vec2(10, 0) }));
+            SPLINE_CHECK(IsCurve(parsed, 0, 1, { glm::vec2(10, 0), glm::vec2(10, -10), glm::vec2(20, -10), glm::vec2(20, 0) }));
+            SPLINE_CHECK(IsCurve(parsed, 0, 2, { glm::vec2(20, 0), glm::vec2(20, 10), glm::vec2(30, 10), glm::vec2(30, 0) }));
+        }
+        {
+            const parsed_path parsed = ParsePath("M0 0 L10 0 S20 10 30 0");
+            SPLINE_CHECK(IsCurve(parsed, 0, 1, { glm::vec2(10, 0), glm::vec2(10, 0), glm::vec2(20, 10), glm::vec2(30, 0) }));
+        }
+
+        // Quadratics are elevated, T reflects the control point of the previous one.
+        {
+            const parsed_path parsed = ParsePath("M0 0 Q6 9 12 0 T24 0");
+            SPLINE_CHECK(HasStatistics(parsed, 1, 2, 0));
+            SPLINE_CHECK(IsCurve(parsed, 0, 0, { glm::vec2(0, 0), glm::vec2(4, 6), glm::vec2(8, 6), glm::vec2(12, 0) }));
+            SPLINE_CHECK(IsCurve(parsed, 0, 1, { glm::vec2(12, 0), glm::vec2(16, -6), glm::vec2(20, -6), glm::vec2(24, 0) }));
+        }
+
+        // Arcs are lines to their end point, flags need no separator.
+        {
+            const parsed_path parsed = ParsePath("M0 0 A5 5 0 1 0 10 0 a5,5,0,0,1,10,0 A5 5 0 1010 10");
+            SPLINE_CHECK(HasStatistics(parsed, 1, 3, 0));
+            SPLINE_CHECK(IsLine(parsed, 0, 0, { 0, 0 }, { 10, 0 }));
+            SPLINE_CHECK(IsLine(parsed, 0, 1, { 10, 0 }, { 20, 0 }));
+            SPLINE_CHECK(IsLine(parsed, 0, 2, { 20, 0 }, { 10, 10 }));
+        }
+
+        // A closepath ends the subpath with a line back to its start, relative commands go on from there.
+        {
+            const parsed_path parsed = ParsePath("M10 10 l10 0 l0 10 z l5 5 Z M0 0 L1 0 1 1 0 0 z");
+            SPLINE_CHECK(HasStatistics(parsed, 3, 8, 0));
+            SPLINE_CHECK(IsLine(parsed, 0, 2, { 20, 20 }, { 10, 10 }));
+            SPLINE_CHECK(IsLine(parsed, 1, 0, { 10, 10 }, { 15, 15 }));
+            SPLINE_CHECK(IsLine(parsed, 1, 1, { 15, 15 }, { 10, 10 }));
+            SPLINE_CHECK(parsed.subpaths.size() == 3 && parsed.subpaths[2].size() == 12);
+        }
+
+        // Numbers end at a sign or at a second decimal point.
+        {
+            const parsed_path parsed = ParsePath("M1-.5.5.5L-1e1+2");
+            SPLINE_CHECK(HasStatistics(parsed, 1, 2, 0));
+            SPLINE_CHECK(IsLine(parsed, 0, 0, { 1, -.5f }, { .5f, .5f }));
+            SPLINE_CHECK(IsLine(parsed, 0, 1, { .5f, .5f }, { -10, 2 }));
+        }
+
+        // Syntax errors stop the path data, the curves before them are kept.
+        {
+            const parsed_path parsed = ParsePath("M0 0 L10 0 L10");
+            SPLINE_CHECK(HasStatistics(parsed, 1, 1, 1));
+        }
+        SPLINE_CHECK(HasStatistics(ParsePath("10 10"), 0, 0, 1));
+        SPLINE_CHECK(HasStatistics(ParsePath("M0 0 L1 1 X5"), 1, 1, 1));
+        SPLINE_CHECK(HasStatistics(ParsePath("M0 0 L1 1 Z 5 5"), 1, 2, 1));
+        SPLINE_CHECK(HasStatistics(ParsePath("M0 0 A5 5 0 2 0 10 0"), 0, 0, 1));
+    }
+
+    // Path data several times the size of the input buffer, numbers crossing its end.
+    void TestLongPath()
+    {
+        constexpr size_t nb_lines = 50000;
+        std::string d = "M0 0";
+        for (size_t i = 0; i < nb_lines; ++i)
+        {
+            d += i % 2 == 0 ? "l1.25,0" : " l1.25 0";
+        }
+
+        const parsed_path parsed = ParsePath(d);
+        SPLINE_CHECK(HasStatistics(parsed, 1, nb_lines, 0));
+        // Sums of 1.25 are exact, the elevated control points are not.
+        SPLINE_CHECK(parsed.subpaths.size() == 1 && parsed.subpaths[0].front() == glm::vec2(0.f));
+        SPLINE_CHECK(parsed.subpaths.size() == 1 && parsed.subpaths[0].back() == glm::vec2(1.25f * nb_lines, 0.f));
+        SPLINE_CHECK(parsed.statistics.nb_bytes > d.size());
+    }
+}
+
+int main()
+{
+    TestReadFloat();
+    TestCommands();
+    TestLongPath();
+
+    return Check::Result();
+}